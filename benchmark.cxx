@@ -0,0 +1,430 @@
+#include <cmath>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <random>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <omp.h>
+#include "src/main.hxx"
+
+using namespace std;
+
+
+
+
+// OPTIONS
+// -------
+// CPU-only benchmark (g++ -std=c++17 -fopenmp -O3 benchmark.cxx).
+
+struct BenchmarkOptions {
+  vector<string> graphs;
+  vector<string> variants;  // key, or key prefix (empty for all)
+  vector<float>  batches {1e-7, 1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1};
+  vector<int>    threads;   // default: omp_get_max_threads()
+  vector<int>    seeds {0};
+  int    repeat = 5;
+  int    steps  = 5;
+  bool   perf   = false;
+  string format = "log";    // log, csv, json
+  string output;            // default: stdout
+};
+
+
+vector<string> splitList(const char *x) {
+  vector<string> a; string s;
+  for (; *x; x++) {
+    if (*x!=',') { s += *x; continue; }
+    if (!s.empty()) a.push_back(s);
+    s.clear();
+  }
+  if (!s.empty()) a.push_back(s);
+  return a;
+}
+
+
+void printUsage(const char *cmd) {
+  fprintf(stderr,
+    "Usage: %s [options] <graph.mtx>...\n"
+    "  -v, --variants <list>  variants to run, by key or prefix (default: all)\n"
+    "  -b, --batches  <list>  batch sizes, as fraction of edges (default: 1e-7,...,1e-1)\n"
+    "  -t, --threads  <list>  no. of threads (default: OMP_NUM_THREADS)\n"
+    "  -s, --seeds    <list>  seeds for random batches (default: 0)\n"
+    "  -r, --repeat   <n>     times each variant repeats its iterations (default: 5)\n"
+    "  -n, --steps    <n>     batches per batch size and seed (default: 5)\n"
+    "  -p, --perf             read hardware counters (perf_event_open)\n"
+    "  -f, --format   <fmt>   output format: log, csv, json (default: log)\n"
+    "  -o, --output   <file>  output file (default: stdout)\n"
+    "  -l, --list             list variants\n", cmd);
+}
+
+
+bool readOptions(BenchmarkOptions& o, int argc, char **argv, bool& list) {
+  for (int i=1; i<argc; i++) {
+    string k = argv[i];
+    bool   v = i+1<argc;
+    if (k=="-h" || k=="--help") return false;
+    else if (k=="-l" || k=="--list") list = true;
+    else if (k=="-p" || k=="--perf") o.perf = true;
+    else if ((k=="-v" || k=="--variants") && v) o.variants = splitList(argv[++i]);
+    else if ((k=="-b" || k=="--batches")  && v) { o.batches.clear(); for (auto& s : splitList(argv[++i])) o.batches.push_back(stof(s)); }
+    else if ((k=="-t" || k=="--threads")  && v) { o.threads.clear(); for (auto& s : splitList(argv[++i])) o.threads.push_back(stoi(s)); }
+    else if ((k=="-s" || k=="--seeds")    && v) { o.seeds.clear();   for (auto& s : splitList(argv[++i])) o.seeds.push_back(stoi(s)); }
+    else if ((k=="-r" || k=="--repeat")   && v) o.repeat = stoi(argv[++i]);
+    else if ((k=="-n" || k=="--steps")    && v) o.steps  = stoi(argv[++i]);
+    else if ((k=="-f" || k=="--format")   && v) o.format = argv[++i];
+    else if ((k=="-o" || k=="--output")   && v) o.output = argv[++i];
+    else if (k[0]=='-') { fprintf(stderr, "Unknown option %s\n", k.c_str()); return false; }
+    else o.graphs.push_back(k);
+  }
+  if (o.threads.empty()) o.threads.push_back(omp_get_max_threads());
+  if (o.format!="log" && o.format!="csv" && o.format!="json") { fprintf(stderr, "Unknown format %s\n", o.format.c_str()); return false; }
+  return list || !o.graphs.empty();
+}
+
+
+
+
+// RECORD
+// ------
+// One row per variant run (on a batch), with time of each phase (ms).
+
+struct BenchmarkRecord {
+  string graph, technique;
+  int    order; size_t size;
+  int    threads, seed, step, batch;
+  float  batchSize;
+  // Batch phases.
+  float  updateGraphTime, updatePagerankDataTime, dynamicVerticesTime, updateCompressionTime;
+  size_t affectedVertices, affectedComponents, compressedVertices;
+  // Variant phases.
+  float  time, wallTime, setupTime;
+  int    iterations;
+  double error;
+  PagerankPhases phases;
+  PerfValues     perf;
+};
+
+
+auto recordFields(const BenchmarkRecord& r) {
+  vector<pair<string, string>> a;
+  auto fs = [&](const char *k, const string& v) { a.push_back({k, "\""+v+"\""}); };
+  auto fi = [&](const char *k, long long v) { char b[32]; snprintf(b, sizeof(b), "%lld", v); a.push_back({k, b}); };
+  auto ff = [&](const char *k, double v)    { char b[32]; snprintf(b, sizeof(b), "%.9g", v);  a.push_back({k, b}); };
+  double ms = r.wallTime;
+  double bw = r.perf.llcMisses<0 || ms<=0? -1 : r.perf.llcMisses * 64 / (ms * 1e6);  // GB/s (cache line per miss)
+  fs("graph", r.graph);
+  fi("order", r.order);
+  fi("size",  r.size);
+  fi("threads", r.threads);
+  fi("seed", r.seed);
+  ff("batch_size", r.batchSize);
+  fi("batch_step", r.step);
+  fi("batch_edges", r.batch);
+  fs("technique", r.technique);
+  ff("time", r.time);
+  fi("iterations", r.iterations);
+  ff("error", r.error);
+  ff("wall_time", r.wallTime);
+  ff("setup_time", r.setupTime);
+  ff("csr_time", r.phases.csr);
+  ff("initialize_time", r.phases.initialize);
+  ff("iterate_time", r.phases.iterate);
+  ff("decompress_time", r.phases.decompress);
+  ff("update_graph_time", r.updateGraphTime);
+  ff("update_pagerank_data_time", r.updatePagerankDataTime);
+  ff("dynamic_vertices_time", r.dynamicVerticesTime);
+  ff("update_compression_time", r.updateCompressionTime);
+  fi("affected_vertices", r.affectedVertices);
+  fi("affected_components", r.affectedComponents);
+  fi("compressed_vertices", r.compressedVertices);
+  fi("perf_cycles", (long long) r.perf.cycles);
+  fi("perf_instructions", (long long) r.perf.instructions);
+  fi("perf_llc_references", (long long) r.perf.llcReferences);
+  fi("perf_llc_misses", (long long) r.perf.llcMisses);
+  ff("perf_bandwidth", bw);
+  return a;
+}
+
+
+
+
+// WRITER
+// ------
+// Log format matches main.cu (read by process.js), CSV and JSON have all fields.
+
+struct BenchmarkWriter {
+  FILE  *out;
+  string format;
+  size_t rows = 0;
+
+  FILE* info() const { return format=="log"? out : stderr; }
+
+  void begin() {
+    if (format=="json") fprintf(out, "[\n");
+  }
+
+  void graph(const char *file, int order, size_t size) {
+    fprintf(info(), "Loading graph %s ...\n", file);
+    fprintf(info(), "order: %d size: %zu {}\n", order, size);
+  }
+
+  void batch(const BenchmarkRecord& r) {
+    auto f = info();
+    fprintf(f, "\n# Batch size %.0e\n", (double) r.batchSize);
+    fprintf(f, "- threads: %d\n", r.threads);
+    fprintf(f, "- seed: %d\n", r.seed);
+  }
+
+  void step(const BenchmarkRecord& r) {
+    if (format!="log") return;
+    fprintf(out, "- batch update size: %d\n", r.batch);
+    fprintf(out, "- update-graph-time: %.3f\n", r.updateGraphTime);
+    fprintf(out, "- update-pagerank-data-time: %.3f\n", r.updatePagerankDataTime);
+    fprintf(out, "- dynamic-vertices-time: %.3f\n", r.dynamicVerticesTime);
+    fprintf(out, "- update-pagerank-compression-time: %.3f\n", r.updateCompressionTime);
+    fprintf(out, "- affected-vertices: %zu\n", r.affectedVertices);
+    fprintf(out, "- affected-components: %zu\n", r.affectedComponents);
+    fprintf(out, "- compressed-vertices: %zu\n", r.compressedVertices);
+  }
+
+  void row(const BenchmarkRecord& r) {
+    if (format=="log") {
+      fprintf(out, "order: %d size: %zu {} [%09.3f ms; %03d iters.] [%.4e err.] %s\n", r.order, r.size, r.time, r.iterations, r.error, r.technique.c_str());
+      return;
+    }
+    auto fs = recordFields(r);
+    if (format=="csv") {
+      if (rows==0) {
+        for (size_t i=0; i<fs.size(); i++)
+          fprintf(out, i? ",%s" : "%s", fs[i].first.c_str());
+        fprintf(out, "\n");
+      }
+      for (size_t i=0; i<fs.size(); i++)
+        fprintf(out, i? ",%s" : "%s", fs[i].second.c_str());
+      fprintf(out, "\n");
+    }
+    else {
+      fprintf(out, rows? ",\n  {" : "  {");
+      for (size_t i=0; i<fs.size(); i++)
+        fprintf(out, i? ", \"%s\": %s" : "\"%s\": %s", fs[i].first.c_str(), fs[i].second.c_str());
+      fprintf(out, "}");
+    }
+    fflush(out);
+    ++rows;
+  }
+
+  void end() {
+    if (format=="json") fprintf(out, "\n]\n");
+    fflush(out);
+  }
+};
+
+
+
+
+// VARIANTS
+// --------
+// Key (for selection) and technique name (as printed by main.cu).
+
+template <class T>
+struct BenchmarkVariant {
+  const char *key;
+  const char *technique;
+  function<PagerankResult<T>()> run;
+};
+
+
+bool selectVariant(const vector<string>& vs, const char *key) {
+  if (vs.empty()) return true;
+  for (const auto& v : vs) {
+    if (v=="all" || v==key) return true;
+    if (strncmp(key, v.c_str(), v.size())==0 && key[v.size()]=='-') return true;
+  }
+  return false;
+}
+
+
+template <class G, class H, class T>
+auto benchmarkVariants(const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const vector<T> *init, const vector<T> *s0, const PagerankCompression& C, const PagerankData<G> *D, int repeat) {
+  enum NormFunction { L0=0, L1=1, L2=2, Li=3 };
+  auto& del = deletions;
+  auto& ins = insertions;
+  PagerankOptions<T> o {repeat, Li};
+  PagerankOptions<T> os {repeat, Li, 1, true};
+  auto oo = [=](int ord, int fmt=EDGES_AUTO) { return PagerankOptions<T> {repeat, Li, 1, false, 0.85f, 1e-10f, 500, 1e-6f, ord, fmt}; };
+  return vector<BenchmarkVariant<T>> {
+    {"monolithic-static",             "pagerankMonolithicOmp (static)",              [=, &y, &yt] { return pagerankMonolithicOmp(y, yt, init, o, D); }},
+    {"monolithic-incremental",        "pagerankMonolithicOmp (incremental)",         [=, &y, &yt] { return pagerankMonolithicOmp(y, yt, s0, o, D); }},
+    {"monolithic-dynamic",            "pagerankMonolithicOmp (dynamic)",             [=, &y, &yt, &del, &ins, &C] { return pagerankMonolithicOmpDynamic(y, yt, del, ins, s0, o, D); }},
+    {"monolithic-frontier",           "pagerankMonolithicOmp (frontier)",            [=, &y, &yt, &del, &ins, &C] { return pagerankMonolithicOmpFrontier(y, yt, del, ins, s0, o, D); }},
+    {"monolithic-split-static",       "pagerankMonolithicOmpSplit (static)",         [=, &y, &yt] { return pagerankMonolithicOmp(y, yt, init, os, D); }},
+    {"monolithic-split-incremental",  "pagerankMonolithicOmpSplit (incremental)",    [=, &y, &yt] { return pagerankMonolithicOmp(y, yt, s0, os, D); }},
+    {"monolithic-split-dynamic",      "pagerankMonolithicOmpSplit (dynamic)",        [=, &y, &yt, &del, &ins, &C] { return pagerankMonolithicOmpDynamic(y, yt, del, ins, s0, os, D); }},
+    {"monolithic-degree-static",      "pagerankMonolithicOmpDegree (static)",        [=, &y, &yt] { return pagerankMonolithicOmp(y, yt, init, oo(ORDER_DEGREE), D); }},
+    {"monolithic-rcm-static",         "pagerankMonolithicOmpRcm (static)",           [=, &y, &yt] { return pagerankMonolithicOmp(y, yt, init, oo(ORDER_RCM), D); }},
+    {"monolithic-component-static",   "pagerankMonolithicOmpComponent (static)",     [=, &y, &yt] { return pagerankMonolithicOmp(y, yt, init, oo(ORDER_COMPONENT), D); }},
+    {"monolithic-compressed-static",  "pagerankMonolithicOmpCompressed (static)",    [=, &y, &yt, &del, &ins, &C] { return pagerankMonolithicOmpCompressed(y, yt, init, o, C, D); }},
+    {"monolithic-compressed-dynamic", "pagerankMonolithicOmpCompressed (dynamic)",   [=, &y, &yt, &del, &ins, &C] { return pagerankMonolithicOmpCompressedDynamic(y, yt, del, ins, s0, o, C, D); }},
+    {"monolithic-packed-static",      "pagerankMonolithicOmpPacked (static)",        [=, &y, &yt] { return pagerankMonolithicOmp(y, yt, init, oo(ORDER_NONE, EDGES_PACKED), D); }},
+    {"monolithic-packed-dynamic",     "pagerankMonolithicOmpPacked (dynamic)",       [=, &y, &yt, &del, &ins, &C] { return pagerankMonolithicOmpDynamic(y, yt, del, ins, s0, oo(ORDER_NONE, EDGES_PACKED), D); }},
+    {"monolithic-offset64-static",    "pagerankMonolithicOmpOffset64 (static)",      [=, &y, &yt] { return pagerankMonolithicOmp(y, yt, init, oo(ORDER_NONE, EDGES_OFFSET64), D); }},
+    {"levelwise-static",              "pagerankLevelwiseOmp (static)",               [=, &y, &yt] { return pagerankLevelwiseOmp(y, yt, init, o, D); }},
+    {"levelwise-incremental",         "pagerankLevelwiseOmp (incremental)",          [=, &y, &yt] { return pagerankLevelwiseOmp(y, yt, s0, o, D); }},
+    {"levelwise-dynamic",             "pagerankLevelwiseOmp (dynamic)",              [=, &y, &yt, &del, &ins, &C] { return pagerankLevelwiseOmpDynamic(y, yt, del, ins, s0, o, D); }},
+    {"levelwise-frontier",            "pagerankLevelwiseOmp (frontier)",             [=, &y, &yt, &del, &ins, &C] { return pagerankLevelwiseOmpFrontier(y, yt, del, ins, s0, o, D); }},
+    {"levelwise-compressed-static",   "pagerankLevelwiseOmpCompressed (static)",     [=, &y, &yt, &del, &ins, &C] { return pagerankLevelwiseOmpCompressed(y, yt, init, o, C, D); }},
+    {"levelwise-compressed-dynamic",  "pagerankLevelwiseOmpCompressed (dynamic)",    [=, &y, &yt, &del, &ins, &C] { return pagerankLevelwiseOmpCompressedDynamic(y, yt, del, ins, s0, o, C, D); }},
+    {"levelwise-packed-static",       "pagerankLevelwiseOmpPacked (static)",         [=, &y, &yt] { return pagerankLevelwiseOmp(y, yt, init, oo(ORDER_NONE, EDGES_PACKED), D); }},
+    {"levelwise-packed-dynamic",      "pagerankLevelwiseOmpPacked (dynamic)",        [=, &y, &yt, &del, &ins, &C] { return pagerankLevelwiseOmpDynamic(y, yt, del, ins, s0, oo(ORDER_NONE, EDGES_PACKED), D); }},
+    {"levelwise-offset64-static",     "pagerankLevelwiseOmpOffset64 (static)",       [=, &y, &yt] { return pagerankLevelwiseOmp(y, yt, init, oo(ORDER_NONE, EDGES_OFFSET64), D); }},
+    {"taskwise-static",               "pagerankTaskwiseOmp (static)",                [=, &y, &yt] { return pagerankTaskwiseOmp(y, yt, init, o, D); }},
+    {"taskwise-incremental",          "pagerankTaskwiseOmp (incremental)",           [=, &y, &yt] { return pagerankTaskwiseOmp(y, yt, s0, o, D); }},
+    {"taskwise-dynamic",              "pagerankTaskwiseOmp (dynamic)",               [=, &y, &yt, &del, &ins, &C] { return pagerankTaskwiseOmpDynamic(y, yt, del, ins, s0, o, D); }}
+  };
+}
+
+
+
+
+// RUN
+// ---
+
+template <class G, class H>
+void runBenchmarkBatch(BenchmarkWriter& w, BenchmarkRecord& rec, const BenchmarkOptions& bo, PerfCounters *P, G& xo, const G& x, const H& xt, const PagerankData<G>& D0, const PagerankCompression& C0, const vector<float>& r0) {
+  using T = float;
+  int span = xo.span();
+  vector<T> *init = nullptr;
+  auto ksOld = vertices(x);
+  default_random_engine rnd(rec.seed);
+  uniform_real_distribution<> dis(0.0, 1.0);
+  w.batch(rec);
+
+  for (int i=0; i<bo.steps; i++) {
+    // Add random edges for this batch (as in main.cu).
+    int batch = int(ceil(rec.batchSize * x.size()));
+    vector<pair<int, int>> deletions, insertions;
+    for (int i=0; i<int(ceil(0.2*batch)); i++) {
+      auto [u, v] = randomEdge(xo, rnd);
+      if (u<0) continue;
+      deletions.push_back({u, v});
+    }
+    for (int i=0; i<int(ceil(0.8*batch)); i++) {
+      int u = int(dis(rnd) * span);
+      int v = int(dis(rnd) * span);
+      if (xo.hasEdge(u, v)) continue;
+      insertions.push_back({u, v});
+    }
+    sort(deletions.begin(), deletions.end());
+    sort(insertions.begin(), insertions.end());
+    deletions.erase(unique(deletions.begin(), deletions.end()), deletions.end());
+    insertions.erase(unique(insertions.begin(), insertions.end()), insertions.end());
+    // Extend batch to self-loops on dead ends (xo is updated in-place, and restored).
+    auto ud = deletions, ui = insertions;
+    auto ws = selfLoopDeadEndsMark(deletions, insertions, xo);
+    xo.updateEdgesOmp(ud, ui);
+    selfLoopDeadEndsExtend(deletions, insertions, ws, xo);
+    xo.updateEdgesOmp(ui, ud);
+    for (const auto& [w, x0] : ws)
+      if (!x.hasVertex(w)) xo.removeIsolatedVertex(w);
+    auto y  = copy(x);
+    auto yt = copy(xt);
+    rec.step  = i;
+    rec.batch = batch;
+    rec.updateGraphTime = measureDuration([&]() { updateGraphOmp(y, yt, deletions, insertions); });
+    auto ks = vertices(y);
+    vector<T> s0(y.span());
+    int X = ksOld.size();
+    int Y = ks.size();
+    adjustRanks(s0, r0, ksOld, ks, 0.0f, float(X)/(Y+1), 1.0f/(Y+1));
+
+    // Update Pagerank data, compression with this batch.
+    auto D = D0;
+    auto C = C0;
+    rec.updatePagerankDataTime = measureDuration([&]() { updatePagerankData(D, y, yt, deletions, insertions); });
+    rec.updateCompressionTime  = measureDuration([&]() { updatePagerankCompression(C, y, yt, deletions, insertions); });
+    rec.dynamicVerticesTime    = measureDuration([&]() {
+      rec.affectedVertices   = dynamicVerticesFrom(y, deletions, insertions).second;
+      rec.affectedComponents = dynamicComponentIndicesFrom(D.components, D.componentIds, D.blockgraph, deletions, insertions).second;
+    });
+    rec.compressedVertices = C.removedVertices;
+    w.step(rec);
+
+    // Reference ranks (for error).
+    auto b0 = pagerankMonolithicOmp(y, yt, init, {1});
+    for (auto& v : benchmarkVariants(y, yt, deletions, insertions, init, &s0, C, &D, bo.repeat)) {
+      if (!selectVariant(bo.variants, v.key)) continue;
+      PagerankResult<T> a {vector<T>()};
+      if (P) P->start();
+      rec.wallTime = measureDuration([&]() { a = v.run(); });
+      rec.perf = P? P->stop() : PerfValues();
+      const auto& t = a.phases;
+      rec.technique  = v.technique;
+      rec.time       = a.time;
+      rec.iterations = a.iterations;
+      rec.error      = l1Norm(a.ranks, b0.ranks);
+      rec.phases     = t;
+      rec.setupTime  = max(0.0f, rec.wallTime - t.csr - t.decompress - bo.repeat*(t.initialize + t.iterate));
+      w.row(rec);
+    }
+  }
+}
+
+
+void runBenchmark(BenchmarkWriter& w, const BenchmarkOptions& o, const char *file) {
+  using T = float;
+  CsrDiGraph<> xo(readMtxCsr(file));
+  string name = file;
+  name = name.substr(name.find_last_of("/\\")+1);
+  name = name.substr(0, name.rfind(".mtx"));
+  w.graph(file, xo.order(), xo.size());
+  auto x  = selfLoop(xo, [&](int u) { return isDeadEnd(xo, u); });
+  auto xt = transposeWithDegree(x);
+  auto D0 = pagerankData(x, xt);
+  auto C0 = pagerankCompression(x, xt);
+  auto r0 = pagerankMonolithicOmp(x, xt, (vector<T>*) nullptr, {1}).ranks;
+  for (int t : o.threads) {
+    omp_set_num_threads(t);
+    unique_ptr<PerfCounters> P(o.perf? new PerfCounters() : nullptr);
+    if (P && !P->valid()) fprintf(stderr, "Hardware counters unavailable (perf_event_open failed)\n");
+    for (float batch : o.batches) {
+      for (int seed : o.seeds) {
+        BenchmarkRecord rec {};
+        rec.graph     = name;
+        rec.order     = x.order();
+        rec.size      = x.size();
+        rec.threads   = t;
+        rec.seed      = seed;
+        rec.batchSize = batch;
+        runBenchmarkBatch(w, rec, o, P && P->valid()? P.get() : nullptr, xo, x, xt, D0, C0, r0);
+      }
+    }
+  }
+  fprintf(w.info(), "\n");
+}
+
+
+int main(int argc, char **argv) {
+  BenchmarkOptions o; bool list = false;
+  if (!readOptions(o, argc, argv, list)) { printUsage(argv[0]); return 1; }
+  if (list) {
+    CsrDiGraph<> x; auto xt = transposeWithDegree(x);
+    vector<pair<int, int>> es; PagerankCompression C;
+    for (auto& v : benchmarkVariants(x, xt, es, es, (vector<float>*) nullptr, (vector<float>*) nullptr, C, (PagerankData<CsrDiGraph<>>*) nullptr, 1))
+      printf("%-32s %s\n", v.key, v.technique);
+    return 0;
+  }
+  FILE *out = o.output.empty()? stdout : fopen(o.output.c_str(), "w");
+  if (!out) { fprintf(stderr, "Cannot open %s\n", o.output.c_str()); return 1; }
+  BenchmarkWriter w {out, o.format};
+  w.begin();
+  for (const auto& file : o.graphs)
+    runBenchmark(w, o, file.c_str());
+  w.end();
+  if (out!=stdout) fclose(out);
+  return 0;
+}
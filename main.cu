@@ -26,7 +26,7 @@ void printRow(const G& x, const PagerankResult<T>& a, const PagerankResult<T>& b
 
 
 template <class G>
-void runPagerankBatch(const G& xo, int repeat, int steps, float batchFraction) {
+void runPagerankBatch(G& xo, int repeat, int steps, float batchFraction, const PagerankData<G> *DC=nullptr) {
   using T = float;
   enum NormFunction { L0=0, L1=1, L2=2, Li=3 };
   int span = int(1 * xo.span());
@@ -35,25 +35,45 @@ void runPagerankBatch(const G& xo, int repeat, int steps, float batchFraction) {
   random_device dev;
   default_random_engine rnd(dev());
 
-  for (int i=0; i<steps; i++) {
-    auto x  = selfLoop(xo, [&](int u) { return isDeadEnd(xo, u); });
-    auto xt = transposeWithDegree(x);
-    auto ksOld = vertices(x);
-    auto a0 = pagerankMonolithicOmp(x, xt, init, {repeat});
-    auto r0 = a0.ranks;
+  auto x  = selfLoop(xo, [&](int u) { return isDeadEnd(xo, u); });
+  auto xt = transposeWithDegree(x);
+  auto ksOld = vertices(x);
+  auto D0 = DC? *DC : pagerankData(x, xt);
+  auto C0 = pagerankCompression(x, xt);
+  auto a0 = pagerankMonolithicOmp(x, xt, init, {repeat});
+  r0 = a0.ranks;
 
+  for (int i=0; i<steps; i++) {
     // Add random edges for this batch.
     int batch = int(ceil(batchFraction * x.size()));
-    auto yo = copy(xo);
-    for (int i=0; i<int(ceil(0.2*batch)); i++)
-      removeRandomEdge(yo, rnd);
-    for (int i=0; i<int(ceil(0.8*batch)); i++)
-      addRandomEdge(yo, rnd, span);
-    // for (int i=0; i<batch; i++)
-    //   addRandomEdgeByDegree(yo, rnd, span);
-    yo.correct();
-    auto y  = selfLoop(yo, [&](int u) { return isDeadEnd(yo, u); });
-    auto yt = transposeWithDegree(y);
+    vector<pair<int, int>> deletions, insertions;
+    uniform_real_distribution<> dis(0.0, 1.0);
+    for (int i=0; i<int(ceil(0.2*batch)); i++) {
+      auto [u, v] = randomEdge(xo, rnd);
+      if (u<0) continue;
+      deletions.push_back({u, v});
+    }
+    for (int i=0; i<int(ceil(0.8*batch)); i++) {
+      int u = int(dis(rnd) * span);
+      int v = int(dis(rnd) * span);
+      if (xo.hasEdge(u, v)) continue;
+      insertions.push_back({u, v});
+    }
+    sort(deletions.begin(), deletions.end());
+    sort(insertions.begin(), insertions.end());
+    deletions.erase(unique(deletions.begin(), deletions.end()), deletions.end());
+    insertions.erase(unique(insertions.begin(), insertions.end()), insertions.end());
+    // Extend batch to self-loops on dead ends (xo is updated in-place, and restored).
+    auto ud = deletions, ui = insertions;
+    auto ws = selfLoopDeadEndsMark(deletions, insertions, xo);
+    xo.updateEdgesOmp(ud, ui);
+    selfLoopDeadEndsExtend(deletions, insertions, ws, xo);
+    xo.updateEdgesOmp(ui, ud);
+    for (const auto& [w, x0] : ws)
+      if (!x.hasVertex(w)) xo.removeIsolatedVertex(w);
+    auto y  = copy(x);
+    auto yt = copy(xt);
+    float tG = measureDuration([&]() { updateGraphOmp(y, yt, deletions, insertions); });
     auto ks = vertices(y);
     vector<T> s0(y.span());
     int X = ksOld.size();
@@ -63,19 +83,24 @@ void runPagerankBatch(const G& xo, int repeat, int steps, float batchFraction) {
     // Adjust ranks for insertions + deletions.
     adjustRanks(s0, r0, ksOld, ks, 0.0f, float(X)/(Y+1), 1.0f/(Y+1));
 
-    // Find Pagerank data.
-    auto cs  = components(y, yt);
-    auto b   = blockgraph(y, cs);
-    auto bt  = transpose(b);
-    auto gs  = levelwiseGroupedComponentsFrom(cs, bt);
-    auto [yks, yn] = dynamicVertices(x, xt, y, yt);
-    auto [ycs, ym] = dynamicComponentIndices(x, xt, y, yt, cs, b);
-    PagerankData<G> D {move(b), move(bt), move(cs)};
+    // Update Pagerank data with this batch.
+    auto D = D0;
+    float tD = measureDuration([&]() { updatePagerankData(D, y, yt, deletions, insertions); });
+    auto C = C0;
+    float tC = measureDuration([&]() { updatePagerankCompression(C, y, yt, deletions, insertions); });
+    auto [yks, yn] = dynamicVerticesFrom(y, deletions, insertions);
+    auto [ycs, ym] = dynamicComponentIndicesFrom(D.components, D.componentIds, D.blockgraph, deletions, insertions);
+    int  levels = 1 + maxAt(D.levels, D.blockgraphTranspose.vertices());
     printf("- batch update size: %d\n", batch);
-    printf("- components: %d\n", b.order());
-    printf("- blockgraph-levels: %zu\n", gs.size());
+    printf("- components: %d\n", D.blockgraph.order());
+    printf("- blockgraph-levels: %d\n", levels);
+    printf("- update-graph-time: %.3f\n", tG);
+    printf("- update-pagerank-data-time: %.3f\n", tD);
     printf("- affected-vertices: %zu\n", yn);
     printf("- affected-components: %zu\n", ym);
+    printf("- update-pagerank-compression-time: %.3f\n", tC);
+    printf("- compressed-vertices: %zu\n", C.removedVertices);
+    printf("- compressed-edges: %zu\n", C.removedEdges);
 
     // Find nvGraph-based pagerank.
     auto b0 = pagerankMonolithicOmp(y, yt, init, {repeat});
@@ -96,8 +121,30 @@ void runPagerankBatch(const G& xo, int repeat, int steps, float batchFraction) {
     printRow(y, b0, h2, "pagerankMonolithicOmpSplit (static)");
     auto i2 = pagerankMonolithicOmp(y, yt, &s0, {repeat, Li, 1, true}, &D);
     printRow(y, b0, i2, "pagerankMonolithicOmpSplit (incremental)");
-    auto j2 = pagerankMonolithicOmpDynamic(x, xt, y, yt, &s0, {repeat, Li, 1, true}, &D);
+    auto j2 = pagerankMonolithicOmpDynamic(y, yt, deletions, insertions, &s0, {repeat, Li, 1, true}, &D);
     printRow(y, b0, j2, "pagerankMonolithicOmpSplit (dynamic)");
+    auto k2 = pagerankMonolithicOmpFrontier(y, yt, deletions, insertions, &s0, {repeat, Li}, &D);
+    printRow(y, b0, k2, "pagerankMonolithicOmp (frontier)");
+
+    // Find OpenMP-based Monolithic pagerank (reordered).
+    auto l2 = pagerankMonolithicOmp(y, yt, init, {repeat, Li, 1, false, 0.85f, 1e-10f, 500, 1e-6f, ORDER_DEGREE}, &D);
+    printRow(y, b0, l2, "pagerankMonolithicOmpDegree (static)");
+    auto m2 = pagerankMonolithicOmp(y, yt, init, {repeat, Li, 1, false, 0.85f, 1e-10f, 500, 1e-6f, ORDER_RCM}, &D);
+    printRow(y, b0, m2, "pagerankMonolithicOmpRcm (static)");
+    auto n2 = pagerankMonolithicOmp(y, yt, init, {repeat, Li, 1, false, 0.85f, 1e-10f, 500, 1e-6f, ORDER_COMPONENT}, &D);
+    printRow(y, b0, n2, "pagerankMonolithicOmpComponent (static)");
+
+    // Find OpenMP-based Monolithic pagerank (compressed).
+    auto o2 = pagerankMonolithicOmpCompressed(y, yt, init, {repeat, Li}, C, &D);
+    printRow(y, b0, o2, "pagerankMonolithicOmpCompressed (static)");
+    auto p2 = pagerankMonolithicOmpCompressedDynamic(y, yt, deletions, insertions, &s0, {repeat, Li}, C, &D);
+    printRow(y, b0, p2, "pagerankMonolithicOmpCompressed (dynamic)");
+
+    // Find OpenMP-based Monolithic pagerank (packed in-edges).
+    auto q2 = pagerankMonolithicOmp(y, yt, init, {repeat, Li, 1, false, 0.85f, 1e-10f, 500, 1e-6f, ORDER_NONE, EDGES_PACKED}, &D);
+    printRow(y, b0, q2, "pagerankMonolithicOmpPacked (static)");
+    auto r2 = pagerankMonolithicOmpDynamic(y, yt, deletions, insertions, &s0, {repeat, Li, 1, false, 0.85f, 1e-10f, 500, 1e-6f, ORDER_NONE, EDGES_PACKED}, &D);
+    printRow(y, b0, r2, "pagerankMonolithicOmpPacked (dynamic)");
 
     // Find CUDA-based Monolithic pagerank.
     // auto b3 = pagerankMonolithicCuda(y, yt, init, {repeat, Li, MIN_COMPUTE_CUDA}, &D);
@@ -120,8 +167,26 @@ void runPagerankBatch(const G& xo, int repeat, int steps, float batchFraction) {
     printRow(y, b0, b5, "pagerankLevelwiseOmp (static)");
     auto c5 = pagerankLevelwiseOmp(y, yt, &s0, {repeat, Li}, &D);
     printRow(y, b0, c5, "pagerankLevelwiseOmp (incremental)");
-    auto d5 = pagerankLevelwiseOmpDynamic(x, xt, y, yt, &s0, {repeat, Li}, &D);
+    auto d5 = pagerankLevelwiseOmpDynamic(y, yt, deletions, insertions, &s0, {repeat, Li}, &D);
     printRow(y, b0, d5, "pagerankLevelwiseOmp (dynamic)");
+    auto e5 = pagerankLevelwiseOmpFrontier(y, yt, deletions, insertions, &s0, {repeat, Li}, &D);
+    printRow(y, b0, e5, "pagerankLevelwiseOmp (frontier)");
+    auto f5 = pagerankLevelwiseOmpCompressed(y, yt, init, {repeat, Li}, C, &D);
+    printRow(y, b0, f5, "pagerankLevelwiseOmpCompressed (static)");
+    auto g5 = pagerankLevelwiseOmpCompressedDynamic(y, yt, deletions, insertions, &s0, {repeat, Li}, C, &D);
+    printRow(y, b0, g5, "pagerankLevelwiseOmpCompressed (dynamic)");
+    auto h5 = pagerankLevelwiseOmp(y, yt, init, {repeat, Li, 1, false, 0.85f, 1e-10f, 500, 1e-6f, ORDER_NONE, EDGES_PACKED}, &D);
+    printRow(y, b0, h5, "pagerankLevelwiseOmpPacked (static)");
+    auto i5 = pagerankLevelwiseOmpDynamic(y, yt, deletions, insertions, &s0, {repeat, Li, 1, false, 0.85f, 1e-10f, 500, 1e-6f, ORDER_NONE, EDGES_PACKED}, &D);
+    printRow(y, b0, i5, "pagerankLevelwiseOmpPacked (dynamic)");
+
+    // Find OpenMP-based Taskwise pagerank.
+    auto b7 = pagerankTaskwiseOmp(y, yt, init, {repeat, Li}, &D);
+    printRow(y, b0, b7, "pagerankTaskwiseOmp (static)");
+    auto c7 = pagerankTaskwiseOmp(y, yt, &s0, {repeat, Li}, &D);
+    printRow(y, b0, c7, "pagerankTaskwiseOmp (incremental)");
+    auto d7 = pagerankTaskwiseOmpDynamic(y, yt, deletions, insertions, &s0, {repeat, Li}, &D);
+    printRow(y, b0, d7, "pagerankTaskwiseOmp (dynamic)");
 
     // Find CUDA-based Levelwise pagerank.
     // auto b6 = pagerankLevelwiseCuda(y, yt, init, {repeat, Li}, &D);
@@ -135,12 +200,12 @@ void runPagerankBatch(const G& xo, int repeat, int steps, float batchFraction) {
 
 
 template <class G>
-void runPagerank(const G& x, int repeat) {
+void runPagerank(G& x, int repeat, const PagerankData<G> *DC=nullptr) {
   vector<float> batches {1e-7, 1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1};
   int M = x.size(), steps = 5;
   for (float batch : batches) {
     printf("\n# Batch size %.0e\n", (double) batch);
-    runPagerankBatch(x, repeat, steps, batch);
+    runPagerankBatch(x, repeat, steps, batch, DC);
   }
 }
 
@@ -148,10 +213,28 @@ void runPagerank(const G& x, int repeat) {
 int main(int argc, char **argv) {
   char *file = argv[1];
   int repeat = argc>2? stoi(argv[2]) : 5;
+  char *snap = argc>3? argv[3] : nullptr;
   omp_set_num_threads(MAX_THREADS);
+  // Load from snapshot (with SCC data), if available.
+  auto s = snap? readCsrSnapshot(snap) : CsrSnapshot();
+  if (s.valid && s.hasComponents) {
+    printf("Loading snapshot %s ...\n", snap);
+    CsrDiGraph<> x(s.graph); println(x);
+    auto D = pagerankDataFrom(x, s.componentIds, s.levels);
+    runPagerank(x, repeat, &D);
+    printf("\n");
+    return 0;
+  }
   printf("Loading graph %s ...\n", file);
-  auto x = readMtx(file); println(x);
-  runPagerank(x, repeat);
+  CsrDiGraph<> x(readMtxCsr(file)); println(x);
+  if (snap) {
+    // Self-loops (added to dead ends) do not change SCCs.
+    auto D = pagerankData(x, transpose(x));
+    printf("Writing snapshot %s ...\n", snap);
+    writeCsrSnapshot(snap, x, &D);
+    runPagerank(x, repeat, &D);
+  }
+  else runPagerank(x, repeat);
   printf("\n");
   return 0;
 }
@@ -0,0 +1,33 @@
+# Phase times of a technique, from benchmark.cxx output:
+# ./a.out -f json -o bench.json ... && node process.js short-csv bench.json data/phase.csv
+set term pdf
+set terminal pdf size 10in,6in
+set output 'output.pdf'
+
+set termoption dashed
+set datafile separator ','
+set key top left
+
+
+set logscale x 10
+set logscale y 10
+set grid xtics
+set xlabel 'Batch size (fraction of edges)'
+set ylabel 'Time (ms)'
+set style line 1 linetype 1 linewidth 3 pointtype 2 pointsize 1
+set style line 2 linetype 2 linewidth 3 pointtype 5 pointsize 1
+set style line 3 linetype 7 linewidth 3 pointtype 7 pointsize 1 dashtype 2
+set style line 4 linetype 6 linewidth 3 pointtype 9 pointsize 1 dashtype 2
+set style line 5 linetype 8 linewidth 3 pointtype 4 pointsize 1 dashtype 3
+
+tec = 'pagerankLevelwiseOmp (dynamic)'
+thr = 32
+x(t) = strcol('technique') eq t && column('threads')==thr? column('batch_size') : NaN
+
+set title sprintf('%s, %d threads', tec, thr)
+plot 'data/phase.csv' \
+      using (x(tec)):'wall_time'                 title 'Total'                 linestyle 1 with linespoints, \
+  ''  using (x(tec)):'iterate_time'              title 'Iterations'            linestyle 2 with linespoints, \
+  ''  using (x(tec)):'setup_time'                title 'Components, affected'  linestyle 3 with linespoints, \
+  ''  using (x(tec)):'update_pagerank_data_time' title 'Update pagerank data'  linestyle 4 with linespoints, \
+  ''  using (x(tec)):'initialize_time'           title 'Initialize'            linestyle 5 with linespoints
@@ -7,6 +7,7 @@ const RORDER = /^order: (\d+) size: (\d+) {}$/m;
 const RBATCH = /^# Batch size ([\d\.e+-]+)/;
 const RFIELD = /^- ([\w\-]+): (.+)/m;
 const RRESLT = /^order: (\d+) size: (\d+) \{\} \[(.*?) ms; (\d+) iters\.\] \[(.*?) err\.\] (.*)/m;
+const RPHASE = /_time$|^perf_/;
 
 
 
@@ -105,24 +106,57 @@ function readLog(pth) {
 }
 
 
+// Rows written by benchmark.cxx (-f json).
+function readJsonLog(pth) {
+  var rows = JSON.parse(readFile(pth));
+  var data = new Map();
+  for (var r of rows) {
+    if (!data.has(r.graph)) data.set(r.graph, []);
+    data.get(r.graph).push(r);
+  }
+  return data;
+}
+
+
 
 
 // PROCESS-*
 // ---------
 
+// Rows of each batch size, and no. of threads (if logged).
+function groupBatchThreads(rows) {
+  var a = [];
+  var batch_sizes = new Set(rows.map(r => r.batch_size));
+  for (var batch_size of batch_sizes) {
+    var rows_batch = rows.filter(r => r.batch_size===batch_size);
+    var threadss = new Set(rows_batch.map(r => r.threads));
+    for (var threads of threadss)
+      a.push(rows_batch.filter(r => r.threads===threads));
+  }
+  return a;
+}
+
+
 function processBatchAverage(rows) {
   var a = [];
   var graph = rows[0].graph;
   var order = Math.max(...rows.map(r => r.order));
   var size = Math.max(...rows.map(r => r.size));
   var batch_size = rows[0].batch_size;
+  var threads = rows[0].threads;
   var techniques = new Set(rows.map(r => r.technique));
   for (var technique of techniques) {
     var rows_filt = rows.filter(r => r.technique===technique);
     var time = avgArray(rows_filt.map(r => r.time));
     var iterations = avgArray(rows_filt.map(r => r.iterations));
     var error = avgArray(rows_filt.map(r => r.error));
-    a.push({graph, order, size, batch_size, technique, time, iterations, error});
+    var row = {graph, order, size, batch_size};
+    if (threads!=null) row.threads = threads;
+    Object.assign(row, {technique, time, iterations, error});
+    // Phase times, hardware counters (benchmark.cxx).
+    for (var k of Object.keys(rows_filt[0]))
+      if (RPHASE.test(k)) row[k] = avgArray(rows_filt.map(r => r[k]));
+    a.push(row);
   }
   return a;
 }
@@ -139,11 +173,8 @@ function processCsv(data) {
 function processShortCsv(data) {
   var a = [];
   for (var rows of data.values()) {
-    var batch_sizes = new Set(rows.map(r => r.batch_size));
-    for (var batch_size of batch_sizes) {
-      var rows_filt = rows.filter(r => r.batch_size===batch_size);
+    for (var rows_filt of groupBatchThreads(rows))
       a.push(...processBatchAverage(rows_filt));
-    }
   }
   return a;
 }
@@ -157,10 +188,10 @@ function processShortLog(data) {
     a += `Using graph ${rows[0].graph} ...\n`;
     a += `Temporal edges: ${rows[0].temporal_edges}\n`;
     a += `order: ${order} size: ${size} {}\n\n`;
-    var batch_sizes = new Set(rows.map(r => r.batch_size));
-    for (var batch_size of batch_sizes) {
-      var rows_filt = rows.filter(r => r.batch_size===batch_size);
-      a += `# Batch size ${batch_size.toExponential(0)}\n`;
+    for (var rows_filt of groupBatchThreads(rows)) {
+      var {batch_size, threads} = rows_filt[0];
+      a += `# Batch size ${batch_size.toExponential(0)}`;
+      a += threads!=null? ` (${threads} threads)\n` : `\n`;
       for (var r of processBatchAverage(rows_filt)) {
         var time = r.time.toFixed(3).padStart(9, '0');
         var iterations = r.iterations.toFixed(0).padStart(3, '0');
@@ -181,7 +212,7 @@ function processShortLog(data) {
 // ----
 
 function main(cmd, log, out) {
-  var data = readLog(log);
+  var data = path.extname(log)==='.json'? readJsonLog(log) : readLog(log);
   if (path.extname(out)==='') cmd += '-dir';
   switch (cmd) {
     case 'csv':
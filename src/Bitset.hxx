@@ -139,3 +139,66 @@ class BitsetSorted {
     ids.erase(it);
   }
 };
+
+
+// Keys only, when there are no values (pair<int, NONE> is padded to 8 bytes).
+template <>
+class BitsetSorted<NONE> {
+  vector<int> ids;
+  bool dirty = false;
+
+  // Cute helpers
+  private:
+  auto where(int id) const {
+    return lower_bound(ids.begin(), ids.end(), id);
+  }
+
+  auto lookup(int id) const {
+    auto it = where(id);
+    return it != ids.end() && *it == id? it : ids.end();
+  }
+
+  // Read as iterable.
+  public:
+  auto entries() const { return transformIter(ids, [](int id) { return pair<int, NONE>(id, NONE()); }); }
+  auto keys()    const { return transformIter(ids, [](int id) { return id; }); }
+  auto values()  const { return transformIter(ids, [](int id) { return NONE(); }); }
+
+  // Read operations.
+  public:
+  size_t size()      const { return ids.size(); }
+  bool   has(int id) const { return lookup(id) != ids.end(); }
+  NONE   get(int id) const { return NONE(); }
+
+  // Write operations
+  public:
+  void correct() {
+    if (!dirty) return;
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+    dirty = false;
+  }
+
+  void clear() {
+    ids.clear();
+  }
+
+  void set(int id, NONE v) {}
+
+  void add(int id, NONE v=NONE()) {
+    ids.push_back(id);
+    dirty = true;
+  }
+
+  void addChecked(int id, NONE v=NONE()) {
+    auto it = where(id);
+    if (it != ids.end() && *it == id) return;
+    ids.insert(it, id);
+  }
+
+  void remove(int id) {
+    auto it = lookup(id);
+    if (it == ids.end()) return;
+    ids.erase(it);
+  }
+};
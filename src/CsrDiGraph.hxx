@@ -0,0 +1,376 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <algorithm>
+#include "_main.hxx"
+#include "CsrGraph.hxx"
+
+using std::pair;
+using std::vector;
+using std::ostream;
+using std::lower_bound;
+using std::sort;
+using std::unique;
+using std::copy;
+using std::copy_backward;
+using std::move;
+using std::swap;
+
+
+
+
+// CSR-DI-GRAPH
+// ------------
+// Mutable graph in CSR format, with some slack space after the edges of each
+// vertex. Edges that do not fit are moved to a larger block at the end (old
+// block becomes garbage, reclaimed by compaction). Edges of each vertex are
+// kept sorted, so a sorted batch of updates can be merged in parallel.
+
+template <class V=NONE>
+class CsrDiGraph {
+  public:
+  using TVertex = V;
+  using TEdge   = NONE;
+
+  private:
+  vector<uint8_t> vex;
+  vector<V>   vdata;
+  vector<size_t> eoff;  // start of block of each vertex (64-bit, slack adds up)
+  vector<int> edeg;     // no. of edges of each vertex
+  vector<int> ecap;     // capacity of block of each vertex
+  vector<int> ekey;     // blocks of edges (destination vertices)
+  int N = 0;
+  size_t M = 0;
+  size_t garbage = 0;   // no. of unused slots in ekey (old blocks)
+
+  // Read operations
+  public:
+  int span()  const { return vex.size(); }
+  int order() const { return N; }
+  size_t size() const { return M; }
+
+  bool hasVertex(int u) const { return u>=0 && u < span() && vex[u]; }
+  bool hasEdge(int u, int v) const {
+    if (u<0 || u >= span()) return false;
+    auto ib = ekey.begin()+eoff[u], ie = ib+edeg[u];
+    auto it = lower_bound(ib, ie, v);
+    return it != ie && *it == v;
+  }
+  auto edges(int u)   const { return u>=0 && u < span()? cpointerIter(ekey.data()+eoff[u], ekey.data()+eoff[u]+edeg[u]) : cpointerIter(ekey.data(), ekey.data()); }
+  int degree(int u)   const { return u>=0 && u < span()? edeg[u] : 0; }
+  auto vertices()     const { return filterIter(rangeIter(span()), [&](int u) { return  vex[u]; }); }
+  auto nonVertices()  const { return filterIter(rangeIter(span()), [&](int u) { return !vex[u]; }); }
+  auto inEdges(int v) const { return filterIter(rangeIter(span()), [&](int u) { return hasEdge(u, v); }); }
+  int inDegree(int v) const { return    countIf(rangeIter(span()), [&](int u) { return hasEdge(u, v); }); }
+
+  V vertexData(int u)   const { return hasVertex(u)? vdata[u] : V(); }
+  void setVertexData(int u, V d) { if (hasVertex(u)) vdata[u] = d; }
+  NONE edgeData(int u, int v) const { return NONE(); }
+  void setEdgeData(int u, int v, NONE d) {}
+
+  // Raw CSR arrays (edges of u are ekey[eoff[u] .. eoff[u]+edeg[u]])
+  public:
+  const vector<uint8_t>& vertexFlags() const { return vex; }
+  const vector<V>&   vertexValues()    const { return vdata; }
+  const vector<size_t>& offsets() const { return eoff; }
+  const vector<int>& degrees()  const { return edeg; }
+  const vector<int>& edgeKeys() const { return ekey; }
+
+  // Slack space for a block of d edges.
+  static int slack(int d) { return d + d/4 + 2; }
+
+  // Write operations
+  private:
+  // Move edges of u to a new block at the end, with room for d edges.
+  void grow(int u, int d) {
+    size_t i = ekey.size(); int c = slack(d);
+    ekey.resize(i + c);
+    copy(ekey.begin()+eoff[u], ekey.begin()+eoff[u]+edeg[u], ekey.begin()+i);
+    garbage += ecap[u];
+    eoff[u] = i;
+    ecap[u] = c;
+  }
+
+  // Copy edges of each vertex from (soff, skey) to a fresh block, with slack space.
+  void compactFrom(const size_t *soff, const int *skey) {
+    int S = span();
+    vector<size_t> offs(S+1);
+    for (int u=0; u<S; u++)
+      offs[u] = slack(edeg[u]);
+    size_t E = exclusiveScan(offs.data(), S+1);
+    vector<int> keys(E);
+    #pragma omp parallel for schedule(dynamic, 2048)
+    for (int u=0; u<S; u++) {
+      copy(skey+soff[u], skey+soff[u]+edeg[u], keys.begin()+offs[u]);
+      ecap[u] = offs[u+1] - offs[u];
+    }
+    offs.pop_back();
+    eoff = move(offs);
+    ekey = move(keys);
+    garbage = 0;
+  }
+
+  public:
+  void correct() {
+    M = 0;
+    for (int u : vertices()) {
+      auto ib = ekey.begin()+eoff[u], ie = ib+edeg[u];
+      sort(ib, ie);
+      edeg[u] = unique(ib, ie) - ib;
+      M += edeg[u];
+    }
+    if (garbage > ekey.size()/2) compact();
+  }
+
+  // Reclaim garbage, and reset slack space of each vertex.
+  void compact() { compactFrom(eoff.data(), ekey.data()); }
+
+  void clear() {
+    vex.clear();
+    vdata.clear();
+    eoff.clear();
+    edeg.clear();
+    ecap.clear();
+    ekey.clear();
+    N = M = garbage = 0;
+  }
+
+  void addVertex(int u, V d=V()) {
+    if (hasVertex(u)) return;
+    if (u >= span()) {
+      vex.resize(u+1);
+      vdata.resize(u+1);
+      eoff.resize(u+1, ekey.size());
+      edeg.resize(u+1);
+      ecap.resize(u+1);
+    }
+    vex[u] = true;
+    vdata[u] = d;
+    N++;
+  }
+
+  // Edges added this way are sorted by correct().
+  void addEdge(int u, int v, NONE d=NONE()) {
+    addVertex(u);
+    addVertex(v);
+    if (edeg[u] == ecap[u]) grow(u, 2*edeg[u]);
+    ekey[eoff[u] + edeg[u]++] = v;
+    M++;
+  }
+
+  void addEdgeChecked(int u, int v, NONE d=NONE()) {
+    if (hasEdge(u, v)) return;
+    addVertex(u);
+    addVertex(v);
+    if (edeg[u] == ecap[u]) grow(u, 2*edeg[u]);
+    auto ib = ekey.begin()+eoff[u], ie = ib+edeg[u];
+    auto it = lower_bound(ib, ie, v);
+    copy_backward(it, ie, ie+1);
+    *it = v;
+    edeg[u]++;
+    M++;
+  }
+
+  void removeEdge(int u, int v) {
+    if (!hasEdge(u, v)) return;
+    auto ib = ekey.begin()+eoff[u], ie = ib+edeg[u];
+    auto it = lower_bound(ib, ie, v);
+    copy(it+1, ie, it);
+    edeg[u]--;
+    M--;
+  }
+
+  void removeEdges(int u) {
+    if (!hasVertex(u)) return;
+    M -= edeg[u];
+    edeg[u] = 0;
+  }
+
+  void removeInEdges(int v) {
+    if (!hasVertex(v)) return;
+    for (int u : vertices())
+      removeEdge(u, v);
+  }
+
+  void removeVertex(int u) {
+    if (!hasVertex(u)) return;
+    removeEdges(u);
+    removeInEdges(u);
+    vex[u] = false;
+    N--;
+  }
+
+  // Caller ensures no in-edges (avoids scanning all vertices).
+  void removeIsolatedVertex(int u) {
+    if (!hasVertex(u)) return;
+    removeEdges(u);
+    vex[u] = false;
+    N--;
+  }
+
+
+  // Apply a batch of edge updates in parallel.
+  // Both lists must be sorted by (source, destination).
+  // Vertices in insertions are added if not present.
+  void updateEdgesOmp(const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions) {
+    for (const auto& [u, v] : insertions) {
+      addVertex(u);
+      addVertex(v);
+    }
+    // Find runs of updates of each source vertex.
+    vector<int> us, ds {0}, is {0};
+    int D = deletions.size(), I = insertions.size();
+    for (int d=0, i=0; d<D || i<I;) {
+      int u = i>=I || (d<D && deletions[d].first < insertions[i].first)? deletions[d].first : insertions[i].first;
+      while (d<D && deletions[d].first==u)  ++d;
+      while (i<I && insertions[i].first==u) ++i;
+      us.push_back(u); ds.push_back(d); is.push_back(i);
+    }
+    // Apply updates of each vertex, if they fit in its block.
+    int R = us.size(), dM = 0;
+    vector<int> ns(R), grows;
+    #pragma omp parallel for schedule(dynamic, 64) reduction(+:dM)
+    for (int r=0; r<R; r++) {
+      int u = us[r], d0 = degree(u);
+      if (!hasVertex(u)) continue;
+      removeEdgesFrom(u, deletions, ds[r], ds[r+1]);
+      ns[r] = countNewEdges(u, insertions, is[r], is[r+1]);
+      dM += edeg[u] + ns[r] - d0;
+      if (edeg[u] + ns[r] <= ecap[u]) { mergeEdges(u, insertions, is[r], is[r+1]); continue; }
+      #pragma omp critical
+      grows.push_back(r);
+    }
+    // Move vertices that do not fit to new blocks at the end.
+    int G = grows.size();
+    size_t E = ekey.size();
+    vector<size_t> olds(G);
+    for (int g=0; g<G; g++) {
+      int r = grows[g], u = us[r];
+      garbage += ecap[u];
+      olds[g]  = eoff[u];
+      eoff[u]  = E;
+      ecap[u]  = slack(edeg[u] + ns[r]);
+      E += ecap[u];
+    }
+    ekey.resize(E);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int g=0; g<G; g++) {
+      int r = grows[g], u = us[r];
+      copy(ekey.begin()+olds[g], ekey.begin()+olds[g]+edeg[u], ekey.begin()+eoff[u]);
+      mergeEdges(u, insertions, is[r], is[r+1]);
+    }
+    M += dM;
+    if (garbage > ekey.size()/2) compact();
+  }
+
+  private:
+  // Remove sorted deletions [i, I) from edges of u.
+  void removeEdgesFrom(int u, const vector<pair<int, int>>& deletions, int i, int I) {
+    auto ib = ekey.begin()+eoff[u], ie = ib+edeg[u], it = ib;
+    for (auto jt=ib; jt!=ie; ++jt) {
+      while (i<I && deletions[i].second < *jt) ++i;
+      if (i<I && deletions[i].second == *jt) continue;
+      *(it++) = *jt;
+    }
+    edeg[u] = it - ib;
+  }
+
+  // Count sorted insertions [i, I) not already in edges of u.
+  int countNewEdges(int u, const vector<pair<int, int>>& insertions, int i, int I) const {
+    auto ib = ekey.begin()+eoff[u], ie = ib+edeg[u], it = ib;
+    int a = 0;
+    for (; i<I; i++) {
+      int v = insertions[i].second;
+      if (i+1<I && insertions[i+1].second==v) continue;
+      while (it!=ie && *it < v) ++it;
+      if (it==ie || *it!=v) ++a;
+    }
+    return a;
+  }
+
+  // Merge sorted insertions [i, I) into edges of u, from the back.
+  // Block of u must have room for them.
+  void mergeEdges(int u, const vector<pair<int, int>>& insertions, int i, int I) {
+    int n = countNewEdges(u, insertions, i, I);
+    if (n==0) return;
+    int *ib = ekey.data()+eoff[u], *xt = ib+edeg[u], *jt = xt+n;
+    for (int k=I-1; k>=i; k--) {
+      int v = insertions[k].second;
+      if (k>i && insertions[k-1].second==v) continue;
+      while (xt!=ib && *(xt-1) > v) *(--jt) = *(--xt);
+      if (xt!=ib && *(xt-1)==v) continue;
+      *(--jt) = v;
+    }
+    edeg[u] += n;
+  }
+
+  // Construct
+  public:
+  CsrDiGraph() {}
+
+  // From CSR arrays (rows sorted, duplicate-free).
+  CsrDiGraph(int S, const uint8_t *vexs, const V *vals, const size_t *offs, const int *keys) {
+    vex.assign(vexs, vexs+S);
+    vdata.resize(S);
+    if (vals) vdata.assign(vals, vals+S);
+    edeg.resize(S);
+    for (int u=0; u<S; u++)
+      edeg[u] = int(offs[u+1] - offs[u]);
+    ecap.resize(S);
+    N = count(vex, uint8_t(1));
+    M = offs[S];
+    compactFrom(offs, keys);  // single copy, with slack space
+  }
+
+  explicit CsrDiGraph(const CsrGraph<V>& x) :
+  CsrDiGraph(x.span(), x.vertexFlags(), x.vertexValues(), x.offsets(), x.edgeKeys()) {}
+};
+
+
+
+
+// CSR-DI-GRAPH PRINT
+// ------------------
+
+template <class V>
+void write(ostream& a, const CsrDiGraph<V>& x, bool all=false) {
+  a << "order: " << x.order() << " size: " << x.size();
+  if (!all) { a << " {}"; return; }
+  a << " {\n";
+  for (int u : x.vertices()) {
+    a << "  " << u << " ->";
+    for (int v : x.edges(u))
+      a << " " << v;
+    a << "\n";
+  }
+  a << "}";
+}
+
+template <class V>
+ostream& operator<<(ostream& a, const CsrDiGraph<V>& x) {
+  write(a, x);
+  return a;
+}
+
+
+
+
+// CSR-DI-GRAPH UPDATE
+// -------------------
+// Update graph, its transpose (with vertex-data=out-degree) together.
+
+template <class V>
+void updateGraphOmp(CsrDiGraph<V>& x, CsrDiGraph<int>& xt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions) {
+  auto fs = [](auto& es) { sort(es.begin(), es.end()); };
+  auto ft = [](auto& es) { for (auto& [u, v] : es) swap(u, v); sort(es.begin(), es.end()); };
+  auto xd = deletions, xi = insertions; fs(xd); fs(xi);
+  auto td = deletions, ti = insertions; ft(td); ft(ti);
+  x.updateEdgesOmp(xd, xi);
+  xt.updateEdgesOmp(td, ti);
+  for (const auto& [u, v] : xd)
+    xt.setVertexData(u, x.degree(u));
+  for (const auto& [u, v] : xi)
+    xt.setVertexData(u, x.degree(u));
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <algorithm>
+#include "_main.hxx"
+
+using std::shared_ptr;
+using std::make_shared;
+using std::vector;
+using std::ostream;
+using std::lower_bound;
+using std::move;
+
+
+
+
+// CSR-GRAPH
+// ---------
+// Read-only graph in Compressed Sparse Row format.
+// Arrays are owned, or borrowed from a memory-mapped file (zero-copy).
+// Offsets are 64-bit, so that graphs with over 2^31 edges can be loaded.
+
+template <class V=NONE>
+class CsrGraph {
+  public:
+  using TVertex = V;
+  using TEdge   = NONE;
+
+  private:
+  shared_ptr<const void> owner;  // keeps arrays alive
+  const uint8_t *vex   = nullptr;
+  const size_t  *eoff  = nullptr;
+  const int     *ekey  = nullptr;
+  const V       *vdata = nullptr;
+  int S = 0, N = 0;
+  size_t M = 0;
+
+  // Read operations
+  public:
+  int span()  const { return S; }
+  int order() const { return N; }
+  size_t size() const { return M; }
+
+  bool hasVertex(int u) const { return u>=0 && u < span() && vex[u]; }
+  bool hasEdge(int u, int v) const {
+    if (u<0 || u >= span()) return false;
+    auto ib = ekey+eoff[u], ie = ekey+eoff[u+1];
+    auto it = lower_bound(ib, ie, v);
+    return it != ie && *it == v;
+  }
+  auto edges(int u)     const { return u>=0 && u < span()? cpointerIter(ekey+eoff[u], ekey+eoff[u+1]) : cpointerIter(ekey, ekey); }
+  int degree(int u)     const { return u>=0 && u < span()? int(eoff[u+1] - eoff[u]) : 0; }
+  auto vertices()       const { return filterIter(rangeIter(span()), [&](int u) { return  vex[u]; }); }
+  auto nonVertices()    const { return filterIter(rangeIter(span()), [&](int u) { return !vex[u]; }); }
+  V vertexData(int u)   const { return vdata && hasVertex(u)? vdata[u] : V(); }
+  NONE edgeData(int u, int v) const { return NONE(); }
+
+  // Raw CSR arrays
+  public:
+  const uint8_t* vertexFlags()  const { return vex; }
+  const size_t*  offsets()      const { return eoff; }
+  const int*     edgeKeys()     const { return ekey; }
+  const V*       vertexValues() const { return vdata; }
+
+  // Construct
+  public:
+  CsrGraph() {}
+
+  // Borrow arrays (owner keeps them alive).
+  CsrGraph(shared_ptr<const void> owner, int S, int N, size_t M, const uint8_t *vex, const size_t *eoff, const int *ekey, const V *vdata=nullptr) :
+  owner(owner), vex(vex), eoff(eoff), ekey(ekey), vdata(vdata), S(S), N(N), M(M) {}
+
+  // Own arrays.
+  CsrGraph(vector<uint8_t>&& vexs, vector<size_t>&& offs, vector<int>&& keys, vector<V>&& vals={}) {
+    struct Arrays { vector<uint8_t> vex; vector<size_t> eoff; vector<int> ekey; vector<V> vdata; };
+    auto a = make_shared<Arrays>();
+    a->vex  = move(vexs);
+    a->eoff = move(offs);
+    a->ekey = move(keys);
+    a->vdata = move(vals);
+    S = a->vex.size();
+    N = count(a->vex, uint8_t(1));
+    M = a->ekey.size();
+    vex   = a->vex.data();
+    eoff  = a->eoff.data();
+    ekey  = a->ekey.data();
+    vdata = a->vdata.empty()? nullptr : a->vdata.data();
+    owner = a;
+  }
+};
+
+
+
+
+// CSR-GRAPH PRINT
+// ---------------
+
+template <class V>
+void write(ostream& a, const CsrGraph<V>& x, bool all=false) {
+  a << "order: " << x.order() << " size: " << x.size();
+  if (!all) { a << " {}"; return; }
+  a << " {\n";
+  for (int u : x.vertices()) {
+    a << "  " << u << " ->";
+    for (int v : x.edges(u))
+      a << " " << v;
+    a << "\n";
+  }
+  a << "}";
+}
+
+template <class V>
+ostream& operator<<(ostream& a, const CsrGraph<V>& x) {
+  write(a, x);
+  return a;
+}
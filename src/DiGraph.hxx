@@ -29,13 +29,14 @@ class DiGraph {
   vector<bool> vex;
   vector<V>    vdata;
   vector<Bitset<E>> edata;
-  int N = 0, M = 0;
+  int N = 0;
+  size_t M = 0;  // may exceed 2^31
 
   // Read operations
   public:
   int span()  const { return vex.size(); }
   int order() const { return N; }
-  int size()  const { return M; }
+  size_t size() const { return M; }
 
   bool hasVertex(int u)      const { return u < span() && vex[u]; }
   bool hasEdge(int u, int v) const { return u < span() && edata[u].has(v); }
@@ -90,7 +91,7 @@ class DiGraph {
     if (hasEdge(u, v)) return;
     addVertex(u);
     addVertex(v);
-    edata[u].add(v, d);
+    edata[u].addChecked(v, d);  // keeps edges sorted, no correct() needed
     M++;
   }
 
@@ -119,6 +120,14 @@ class DiGraph {
     vex[u] = false;
     N--;
   }
+
+  // Caller ensures no in-edges (avoids scanning all vertices).
+  void removeIsolatedVertex(int u) {
+    if (!hasVertex(u)) return;
+    removeEdges(u);
+    vex[u] = false;
+    N--;
+  }
 };
 
 
@@ -3,8 +3,10 @@
 #include <algorithm>
 #include <cstdio>
 #include <cstdlib>
+#ifdef __CUDACC__
 #include <cuda_runtime.h>
 #include <cuda_profiler_api.h>
+#endif
 
 using std::min;
 using std::max;
@@ -45,6 +47,12 @@ constexpr int GRID_DIM_R() noexcept  { return GRID_DIM_RM<T>(); }
 
 
 
+// Everything below needs nvcc (launch config above does not).
+#ifdef __CUDACC__
+
+
+
+
 // TRY
 // ---
 // Log error if CUDA function call fails.
@@ -822,3 +830,4 @@ template <class T>
 void liNormCu(T *a, const T *x, const T *y, int N) {
   liNormMemcpyCu(a, x, y, N);
 }
+#endif
@@ -287,6 +287,7 @@ class PointerIterator {
   ITERATOR_ARITHMETICP(iterator, a, n, iterator(a.it+n))
   ITERATOR_ARITHMETICN(iterator, a, n, iterator(a.it-n))
   ITERATOR_COMPARISION(iterator, a, b, a.it, b.it)
+  friend difference_type operator-(const iterator& a, const iterator& b) { return a.it-b.it; }
 };
 
 template <class T>
@@ -304,6 +305,7 @@ class ConstPointerIterator {
   ITERATOR_ARITHMETICP(iterator, a, n, iterator(a.it+n))
   ITERATOR_ARITHMETICN(iterator, a, n, iterator(a.it-n))
   ITERATOR_COMPARISION(iterator, a, b, a.it, b.it)
+  friend difference_type operator-(const iterator& a, const iterator& b) { return a.it-b.it; }
 };
 
 
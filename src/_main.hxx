@@ -5,8 +5,12 @@
 #include "_cuda.hxx"
 #include "_iostream.hxx"
 #include "_iterator.hxx"
+#include "_mmap.hxx"
 // #include "_nvgraph.hxx"
 #include "_openmp.hxx"
+#include "_perf.hxx"
+#include "_simd.hxx"
 #include "_string.hxx"
 #include "_utility.hxx"
+#include "_varint.hxx"
 #include "_vector.hxx"
@@ -0,0 +1,51 @@
+#pragma once
+#include <memory>
+#include <cstddef>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using std::shared_ptr;
+using std::make_shared;
+
+
+
+
+// MAPPED-FILE
+// -----------
+// Read-only memory-mapped file (unmapped on destruction).
+
+class MappedFile {
+  int    fd = -1;
+  void  *addr = nullptr;
+  size_t N = 0;
+
+  public:
+  const char* data() const { return (const char*) addr; }
+  size_t size()      const { return N; }
+  bool   empty()     const { return addr==nullptr; }
+
+  MappedFile(const char *pth) {
+    struct stat st;
+    fd = open(pth, O_RDONLY);
+    if (fd<0 || fstat(fd, &st)<0 || st.st_size==0) return;
+    N = st.st_size;
+    addr = mmap(nullptr, N, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr==MAP_FAILED) { addr = nullptr; N = 0; return; }
+    madvise(addr, N, MADV_SEQUENTIAL);
+  }
+
+  ~MappedFile() {
+    if (addr) munmap(addr, N);
+    if (fd>=0) close(fd);
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+};
+
+
+auto mapFile(const char *pth) {
+  return make_shared<MappedFile>(pth);
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <omp.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+using std::vector;
+using std::memset;
+
+
+
+
+// PERF-COUNTERS
+// -------------
+// Hardware counters of all OpenMP threads, read through perf_event_open (Linux).
+// Each thread of the team opens its own counters, so the no. of threads must
+// not change between opening and reading them. Values are -1 if unavailable.
+
+struct PerfValues {
+  double cycles        = -1;
+  double instructions  = -1;
+  double llcReferences = -1;
+  double llcMisses     = -1;
+};
+
+
+class PerfCounters {
+  static constexpr int E = 4;  // events per thread
+  vector<int> fds;  // counter of each thread, event
+  vector<int> evs;  // event of each counter
+
+  public:
+  bool valid() const { return !fds.empty(); }
+
+#ifdef __linux__
+  PerfCounters() {
+    const uint64_t cfgs[E] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES};
+    bool ok = true;
+    #pragma omp parallel
+    {
+      for (int i=0; i<E; i++) {
+        perf_event_attr pe;
+        memset(&pe, 0, sizeof(pe));
+        pe.type   = PERF_TYPE_HARDWARE;
+        pe.size   = sizeof(pe);
+        pe.config = cfgs[i];
+        pe.disabled       = 1;
+        pe.exclude_kernel = 1;
+        pe.exclude_hv     = 1;
+        pe.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        int fd = syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0);  // this thread, any cpu
+        #pragma omp critical
+        {
+          if (fd<0) ok = false;
+          else { fds.push_back(fd); evs.push_back(i); }
+        }
+      }
+    }
+    if (!ok) close();
+  }
+
+  ~PerfCounters() { close(); }
+
+  void close() {
+    for (int fd : fds)
+      ::close(fd);
+    fds.clear();
+    evs.clear();
+  }
+
+  void start() {
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+
+  PerfValues stop() {
+    PerfValues a;
+    if (!valid()) return a;
+    double vs[E] = {};
+    for (int fd : fds)
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    for (size_t i=0; i<fds.size(); i++) {
+      uint64_t d[3] = {};  // value, time enabled, time running
+      if (read(fds[i], d, sizeof(d)) != sizeof(d)) continue;
+      vs[evs[i]] += d[2]>0? double(d[0]) * d[1] / d[2] : 0;  // scale if multiplexed
+    }
+    a.cycles        = vs[0];
+    a.instructions  = vs[1];
+    a.llcReferences = vs[2];
+    a.llcMisses     = vs[3];
+    return a;
+  }
+#else
+  PerfCounters() {}
+  void close() {}
+  void start() {}
+  PerfValues stop() { return PerfValues(); }
+#endif
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+};
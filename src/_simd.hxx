@@ -0,0 +1,88 @@
+#pragma once
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+
+
+
+// GATHER-SUM
+// ----------
+// Sum of values at given indices (x[is[0]] + x[is[1]] + ...).
+// Uses AVX-512 / AVX2 gathers when enabled (eg. -march=native).
+// Masked gathers / extracts (zero source) avoid GCC 12 -Wmaybe-uninitialized.
+
+template <class T>
+T gatherSum(const T *x, const int *is, int N) {
+  T a = T();
+  for (int i=0; i<N; i++)
+    a += x[is[i]];
+  return a;
+}
+
+
+#if defined(__AVX512F__)
+template <>
+float gatherSum<float>(const float *x, const int *is, int N) {
+  __m512 s = _mm512_setzero_ps(); int i = 0;
+  for (; i+16<=N; i+=16) {
+    __m512i k = _mm512_loadu_si512((const void*) (is+i));
+    s = _mm512_add_ps(s, _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, k, x, 4));
+  }
+  __m512d d = _mm512_castps_pd(s);
+  __m256  g = _mm256_add_ps(_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, d, 0)), _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, d, 1)));
+  __m128 h = _mm_add_ps(_mm256_castps256_ps128(g), _mm256_extractf128_ps(g, 1));
+  h = _mm_hadd_ps(h, h); h = _mm_hadd_ps(h, h);
+  float a = _mm_cvtss_f32(h);
+  for (; i<N; i++)
+    a += x[is[i]];
+  return a;
+}
+
+template <>
+double gatherSum<double>(const double *x, const int *is, int N) {
+  __m512d s = _mm512_setzero_pd(); int i = 0;
+  for (; i+8<=N; i+=8) {
+    __m256i k = _mm256_loadu_si256((const __m256i*) (is+i));
+    s = _mm512_add_pd(s, _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, k, x, 8));
+  }
+  __m256d g = _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xFF, s, 0), _mm512_maskz_extractf64x4_pd(0xFF, s, 1));
+  __m128d h = _mm_add_pd(_mm256_castpd256_pd128(g), _mm256_extractf128_pd(g, 1));
+  h = _mm_hadd_pd(h, h);
+  double a = _mm_cvtsd_f64(h);
+  for (; i<N; i++)
+    a += x[is[i]];
+  return a;
+}
+
+#elif defined(__AVX2__)
+template <>
+float gatherSum<float>(const float *x, const int *is, int N) {
+  __m256 s = _mm256_setzero_ps(); int i = 0;
+  for (; i+8<=N; i+=8) {
+    __m256i k = _mm256_loadu_si256((const __m256i*) (is+i));
+    s = _mm256_add_ps(s, _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, k, _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4));
+  }
+  __m128 h = _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1));
+  h = _mm_hadd_ps(h, h); h = _mm_hadd_ps(h, h);
+  float a = _mm_cvtss_f32(h);
+  for (; i<N; i++)
+    a += x[is[i]];
+  return a;
+}
+
+template <>
+double gatherSum<double>(const double *x, const int *is, int N) {
+  __m256d s = _mm256_setzero_pd(); int i = 0;
+  for (; i+4<=N; i+=4) {
+    __m128i k = _mm_loadu_si128((const __m128i*) (is+i));
+    s = _mm256_add_pd(s, _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, k, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8));
+  }
+  __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1));
+  h = _mm_hadd_pd(h, h);
+  double a = _mm_cvtsd_f64(h);
+  for (; i<N; i++)
+    a += x[is[i]];
+  return a;
+}
+#endif
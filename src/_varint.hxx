@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+
+
+
+
+// VARINT
+// ------
+// Unsigned integers in 7-bit groups, low group first (LEB128).
+// High bit of each byte is set if more bytes follow.
+
+int varintSize(uint32_t x) {
+  int n = 1;
+  for (; x>=0x80; x>>=7) n++;
+  return n;
+}
+
+
+uint8_t* writeVarint(uint8_t *a, uint32_t x) {
+  for (; x>=0x80; x>>=7)
+    *a++ = uint8_t(x) | 0x80;
+  *a++ = uint8_t(x);
+  return a;
+}
+
+
+uint32_t readVarint(const uint8_t *&p) {
+  uint32_t x = *p++;
+  if (x<0x80) return x;  // most gaps fit in a byte
+  x &= 0x7F;
+  for (int s=7;; s+=7) {
+    uint32_t b = *p++;
+    x |= (b & 0x7F) << s;
+    if (b<0x80) return x;
+  }
+}
+
+
+
+
+// DELTA-VARINT
+// ------------
+// Sorted indices as varint gaps (first index is a gap from 0).
+
+int64_t deltaVarintSize(const int *is, int N) {
+  int64_t a = 0; uint32_t u = 0;
+  for (int i=0; i<N; i++) {
+    a += varintSize(uint32_t(is[i]) - u);
+    u  = is[i];
+  }
+  return a;
+}
+
+
+uint8_t* writeDeltaVarint(uint8_t *a, const int *is, int N) {
+  uint32_t u = 0;
+  for (int i=0; i<N; i++) {
+    a = writeVarint(a, uint32_t(is[i]) - u);
+    u = is[i];
+  }
+  return a;
+}
+
+
+// Sum of values at delta-varint coded indices in bytes [ib, ie).
+template <class T>
+T gatherSumDeltaVarint(const T *x, const uint8_t *ib, const uint8_t *ie) {
+  T a = T(); uint32_t u = 0;
+  for (const uint8_t *p=ib; p<ie;) {
+    u += readVarint(p);
+    a += x[u];
+  }
+  return a;
+}
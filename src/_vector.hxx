@@ -357,7 +357,7 @@ void copy(vector<T>& a, const vector<T>& x, int i, int N) {
 template <class T, class U>
 void copyOmp(T *a, U *x, int N) {
   if (N<SIZE_MIN_OMPM) { copy(a, x, N); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(auto)
   for (int i=0; i<N; i++)
     a[i] = x[i];
 }
@@ -398,7 +398,7 @@ void fill(vector<T>& a, int i, int N, const U& v) {
 template <class T, class U>
 void fillOmp(T *a, int N, const U& v) {
   if (N<SIZE_MIN_OMPM) { fill(a, N, v); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(auto)
   for (int i=0; i<N; i++)
     a[i] = v;
 }
@@ -462,7 +462,7 @@ U sum(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U sumOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return sum(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(auto) reduction(+:a)
   for (int i=0; i<N; i++)
     a += x[i];
   return a;
@@ -481,6 +481,28 @@ U sumOmp(const vector<T>& x, int i, int N, U a=U()) {
 
 
 
+// EXCLUSIVE-SCAN
+// --------------
+// Replace each value with sum of values before it (returns total).
+
+template <class T>
+T exclusiveScan(T *a, int N) {
+  T s = T();
+  for (int i=0; i<N; i++) {
+    T v = a[i];
+    a[i] = s; s += v;
+  }
+  return s;
+}
+
+template <class T>
+T exclusiveScan(vector<T>& a) {
+  return exclusiveScan(a.data(), int(a.size()));
+}
+
+
+
+
 // SUM-ABS
 // -------
 
@@ -511,7 +533,7 @@ U sumAbs(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U sumAbsOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return sumAbs(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(auto) reduction(+:a)
   for (int i=0; i<N; i++)
     a += abs(x[i]);
   return a;
@@ -554,7 +576,7 @@ U sumSqr(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U sumSqrOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return sumSqr(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(auto) reduction(+:a)
   for (int i=0; i<N; i++)
     a += x[i]*x[i];
   return a;
@@ -619,7 +641,7 @@ void addValue(vector<T>& a, int i, int N, const U& v) {
 template <class T, class U>
 void addValueOmp(T *a, int N, const U& v) {
   if (N<SIZE_MIN_OMPM) { addValue(a, N, v); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(auto)
   for (int i=0; i<N; i++)
     a[i] += v;
 }
@@ -683,7 +705,7 @@ U max(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U maxOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return max(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(auto) reduction(+:a)
   for (int i=0; i<N; i++)
     a = max(a, x[i]);
   return a;
@@ -726,7 +748,7 @@ U maxAbs(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U maxAbsOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return maxAbs(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(auto) reduction(+:a)
   for (int i=0; i<N; i++)
     a = max(a, abs(x[i]));
   return a;
@@ -791,7 +813,7 @@ void maxValue(vector<T>& a, int i, int N, const U& v) {
 template <class T, class U>
 void maxValueOmp(T *a, int N, const U& v) {
   if (N<SIZE_MIN_OMPM) { maxValue(a, N, v); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(auto)
   for (int i=0; i<N; i++)
     a[i] = max(a[i], v);
 }
@@ -855,7 +877,7 @@ U min(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U minOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return min(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(auto) reduction(+:a)
   for (int i=0; i<N; i++)
     a = min(a, x[i]);
   return a;
@@ -898,7 +920,7 @@ U minAbs(const vector<T>& x, int i, int N, U a=U()) {
 template <class T, class U=T>
 U minAbsOmp(const T *x, int N, U a=U()) {
   if (N<SIZE_MIN_OMPR) return minAbs(x, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(auto) reduction(+:a)
   for (int i=0; i<N; i++)
     a = min(a, abs(x[i]));
   return a;
@@ -963,7 +985,7 @@ void minValue(vector<T>& a, int i, int N, const U& v) {
 template <class T, class U>
 void minValueOmp(T *a, int N, const U& v) {
   if (N<SIZE_MIN_OMPM) { minValue(a, N, v); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(auto)
   for (int i=0; i<N; i++)
     a[i] = min(a[i], v);
 }
@@ -1027,7 +1049,7 @@ V l1Norm(const vector<T>& x, const vector<U>& y, int i, int N, V a=V()) {
 template <class T, class U, class V=T>
 V l1NormOmp(const T *x, const U *y, int N, V a=V()) {
   if (N<SIZE_MIN_OMPR) return l1Norm(x, y, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(auto) reduction(+:a)
   for (int i=0; i<N; i++)
     a += abs(x[i] - y[i]);
   return a;
@@ -1070,7 +1092,7 @@ V l2Norm(const vector<T>& x, const vector<U>& y, int i, int N, V a=V()) {
 template <class T, class U, class V=T>
 V l2NormOmp(const T *x, const U *y, int N, V a=V()) {
   if (N<SIZE_MIN_OMPR) return l2Norm(x, y, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(auto) reduction(+:a)
   for (int i=0; i<N; i++)
     a += (x[i] - y[i]) * (x[i] - y[i]);
   return sqrt(a);
@@ -1113,7 +1135,7 @@ V liNorm(const vector<T>& x, const vector<U>& y, int i, int N, V a=V()) {
 template <class T, class U, class V=T>
 V liNormOmp(const T *x, const U *y, int N, V a=V()) {
   if (N<SIZE_MIN_OMPR) return liNorm(x, y, N, a);
-  #pragma omp parallel for num_threads(32) schedule(auto) reduction(+:a)
+  #pragma omp parallel for schedule(auto) reduction(+:a)
   for (int i=0; i<N; i++)
     a = max(a, abs(x[i] - y[i]));
   return a;
@@ -1155,7 +1177,7 @@ void multiply(vector<T>& a, const vector<U>& x, const vector<V>& y, int i, int N
 template <class T, class U, class V>
 void multiplyOmp(T *a, const U *x, const V *y, int N) {
   if (N<SIZE_MIN_OMPM) { multiply(a, x, y, N); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(auto)
   for (int i=0; i<N; i++)
     a[i] = x[i] * y[i];
 }
@@ -1196,7 +1218,7 @@ void multiplyValue(vector<T>& a, const vector<U>& x, const V& v, int i, int N) {
 template <class T, class U, class V>
 void multiplyValueOmp(T *a, const U *x, const V& v, int N) {
   if (N<SIZE_MIN_OMPM) { multiplyValue(a, x, v, N); return; }
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(auto)
   for (int i=0; i<N; i++)
     a[i] = T(x[i] * v);
 }
@@ -30,14 +30,16 @@ auto chainsFromSize(const G& x, const H& xt, const J& ks, int n) {
     b.clear();
     // Traverse back.
     int u = chainTraverse(b, vis, xt, x, v);
+    bool iv = b.size()>0;  // v was traversed (interior)
     if (x.degree(u)==1) b.push_back(u);
     reverse(b.begin(), b.end());
-    if (b.size()>0) b.pop_back();
-    // Traverse front.
-    int w = chainTraverse(b, vis, x, xt, v);
+    // Traverse front (past v, as it is already visited).
+    int w = v;
+    if (iv) w = chainTraverse(b, vis, x, xt, edge(x, v));
+    else if (b.size()>0) b.pop_back();
     if (xt.degree(w)==1) b.push_back(w);
     // Record chain.
-    if (b.size()<n) continue;
+    if (int(b.size())<n) continue;
     a.push_back(b);
   }
   return a;
@@ -36,11 +36,11 @@ auto components(const G& x, const H& xt) {
 
 // COMPONENTS-IDS
 // --------------
-// Get component id of each vertex.
+// Get component id of each vertex (-1 if not a vertex).
 
 template <class G>
 auto componentIds(const G& x, const vector2d<int>& cs) {
-  auto a = createContainer(x, int()); int i = 0;
+  vector<int> a(x.span(), -1); int i = 0;
   for (const auto& c : cs) {
     for (int u : c)
       a[u] = i;
@@ -1,4 +1,5 @@
 #pragma once
+#include "CsrDiGraph.hxx"
 
 
 
@@ -47,3 +48,8 @@ auto copy(const G& x) {
   G a; copyTo(a, x);
   return a;
 }
+
+template <class V>
+auto copy(const CsrDiGraph<V>& x) {
+  return x;  // arrays are contiguous
+}
@@ -1,21 +1,27 @@
 #pragma once
+#include <utility>
 #include <vector>
 #include <algorithm>
 #include "_main.hxx"
 
 using std::vector;
 using std::transform;
+using std::sort;
+using std::unique;
+using std::make_pair;
+using std::move;
 
 
 
 
 // SOURCE-OFFSETS
 // --------------
+// Offsets are 32-bit by default, use O=int64_t for over 2^31 edges.
 
-template <class G, class J>
+template <class O=int, class G, class J>
 auto sourceOffsets(const G& x, const J& ks) {
-  int i = 0;
-  vector<int> a;
+  O i = 0;
+  vector<O> a;
   a.reserve(x.order()+1);
   for (auto u : ks) {
     a.push_back(i);
@@ -25,9 +31,9 @@ auto sourceOffsets(const G& x, const J& ks) {
   return a;
 }
 
-template <class G>
+template <class O=int, class G>
 auto sourceOffsets(const G& x) {
-  return sourceOffsets(x, x.vertices());
+  return sourceOffsets<O>(x, x.vertices());
 }
 
 
@@ -57,3 +63,57 @@ template <class G>
 auto destinationIndices(const G& x) {
   return destinationIndices(x, x.vertices());
 }
+
+
+
+
+// CSR-FROM-EDGES
+// --------------
+// Build sorted, duplicate-free CSR (offsets, keys) in parallel.
+// Offsets are 64-bit, so that over 2^31 edges can be loaded.
+// @param S  span (no. of rows)
+// @param P  no. of edge chunks
+// @param fe for-each edge (u, v) in chunk: fe(chunk, fn)
+
+template <class FE>
+auto csrFromEdgesOmp(int S, int P, FE fe) {
+  vector<size_t> offs(S+1), degs(S+1);
+  // Count edges of each row.
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (int t=0; t<P; t++) {
+    fe(t, [&](int u, int v) {
+      #pragma omp atomic
+      ++degs[u];
+    });
+  }
+  size_t M = exclusiveScan(degs);
+  vector<int> keys(M);
+  copyOmp(offs, degs);
+  // Scatter edges to their rows.
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (int t=0; t<P; t++) {
+    fe(t, [&](int u, int v) {
+      size_t i;
+      #pragma omp atomic capture
+      i = degs[u]++;
+      keys[i] = v;
+    });
+  }
+  // Sort rows, and drop duplicates.
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (int u=0; u<S; u++) {
+    auto ib = keys.begin()+offs[u], ie = keys.begin()+offs[u+1];
+    sort(ib, ie);
+    degs[u] = unique(ib, ie) - ib;
+  }
+  degs[S] = 0;
+  size_t MU = exclusiveScan(degs);
+  if (MU==M) return make_pair(move(offs), move(keys));
+  vector<int> ukeys(MU);
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (int u=0; u<S; u++) {
+    for (size_t i=degs[u], j=offs[u]; i<degs[u+1]; i++, j++)
+      ukeys[i] = keys[j];
+  }
+  return make_pair(move(degs), move(ukeys));
+}
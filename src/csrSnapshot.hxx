@@ -0,0 +1,208 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include "_main.hxx"
+#include "CsrGraph.hxx"
+#include "pagerank.hxx"
+
+using std::vector;
+using std::ofstream;
+using std::memcmp;
+using std::memcpy;
+using std::ios;
+
+
+
+
+// CSR-SNAPSHOT
+// ------------
+// Versioned binary snapshot of a graph, optionally with SCC data (component
+// ids, levels). Sections are 64-byte aligned, so that they can be read
+// in-place from a memory-mapped file. The transpose is not stored, as
+// pagerank runs on the graph with self-loops (and finds its own transpose).
+// Offsets are 64-bit (since version 3), edge keys and SCC data 32-bit.
+
+#define CSR_SNAPSHOT_MAGIC   "PRCSR\0\0\0"
+#define CSR_SNAPSHOT_VERSION 3
+#define CSR_SNAPSHOT_ALIGN   64
+
+enum CsrSnapshotFlags : uint32_t {
+  CSR_SNAPSHOT_COMPONENTS = 1
+};
+
+enum CsrSnapshotSection {
+  CSR_SNAPSHOT_VERTICES = 0,
+  CSR_SNAPSHOT_OFFSETS,
+  CSR_SNAPSHOT_EDGES,
+  CSR_SNAPSHOT_COMPONENT_IDS,
+  CSR_SNAPSHOT_LEVELS,
+  CSR_SNAPSHOT_SECTIONS
+};
+
+struct CsrSnapshotHeader {
+  char     magic[8];
+  uint32_t version;
+  uint32_t flags;
+  int64_t  span;
+  int64_t  order;
+  int64_t  size;
+  int64_t  components;  // number of levels
+  uint64_t offsets[CSR_SNAPSHOT_SECTIONS];
+  uint64_t bytes[CSR_SNAPSHOT_SECTIONS];
+};
+
+
+struct CsrSnapshot {
+  CsrGraph<>  graph;
+  vector<int> componentIds;
+  vector<int> levels;
+  bool hasComponents = false;
+  bool valid = false;
+};
+
+
+
+
+// WRITE-CSR-SNAPSHOT
+// ------------------
+
+template <class FW>
+void writeCsrSnapshotSection(ofstream& f, CsrSnapshotHeader& h, int i, size_t bytes, FW fw) {
+  static const char zero[CSR_SNAPSHOT_ALIGN] = {};
+  size_t p = f.tellp(), q = ceilDiv(p, size_t(CSR_SNAPSHOT_ALIGN)) * CSR_SNAPSHOT_ALIGN;
+  f.write(zero, q-p);
+  h.offsets[i] = q;
+  h.bytes[i]   = bytes;
+  fw();
+}
+
+template <class G>
+void writeCsrSnapshotOffsets(ofstream& f, const G& x) {
+  size_t i = 0;
+  for (int u=0; u<x.span(); u++) {
+    f.write((const char*) &i, sizeof(size_t));
+    i += x.degree(u);
+  }
+  f.write((const char*) &i, sizeof(size_t));
+}
+
+template <class G>
+void writeCsrSnapshotEdges(ofstream& f, const G& x) {
+  for (int u=0; u<x.span(); u++) {
+    for (int v : x.edges(u))
+      f.write((const char*) &v, sizeof(int));
+  }
+}
+
+
+// Write snapshot of graph (x), and SCC data (D, optional).
+// @returns success?
+template <class G, class B=G>
+bool writeCsrSnapshot(const char *pth, const G& x, const PagerankData<B> *D=nullptr) {
+  ofstream f(pth, ios::binary);
+  if (!f) return false;
+  int S = x.span();
+  CsrSnapshotHeader h = {};
+  memcpy(h.magic, CSR_SNAPSHOT_MAGIC, sizeof(h.magic));
+  h.version = CSR_SNAPSHOT_VERSION;
+  h.flags   = D? uint32_t(CSR_SNAPSHOT_COMPONENTS) : 0;
+  h.span  = S;
+  h.order = x.order();
+  h.size  = x.size();
+  h.components = D? D->levels.size() : 0;
+  f.write((const char*) &h, sizeof(h));
+  writeCsrSnapshotSection(f, h, CSR_SNAPSHOT_VERTICES, S, [&]() {
+    for (int u=0; u<S; u++)
+      f.put(x.hasVertex(u)? 1 : 0);
+  });
+  writeCsrSnapshotSection(f, h, CSR_SNAPSHOT_OFFSETS, (S+1)*sizeof(size_t), [&]() { writeCsrSnapshotOffsets(f, x); });
+  writeCsrSnapshotSection(f, h, CSR_SNAPSHOT_EDGES, x.size()*sizeof(int), [&]() { writeCsrSnapshotEdges(f, x); });
+  if (D) {
+    vector<int> cids = D->componentIds;
+    cids.resize(S, -1);
+    writeCsrSnapshotSection(f, h, CSR_SNAPSHOT_COMPONENT_IDS, S*sizeof(int), [&]() { f.write((const char*) cids.data(), S*sizeof(int)); });
+    writeCsrSnapshotSection(f, h, CSR_SNAPSHOT_LEVELS, h.components*sizeof(int), [&]() { f.write((const char*) D->levels.data(), h.components*sizeof(int)); });
+  }
+  f.seekp(0);
+  f.write((const char*) &h, sizeof(h));
+  return bool(f);
+}
+
+
+
+
+// READ-CSR-SNAPSHOT
+// -----------------
+// Graph arrays are borrowed from the mapping (not copied). A mutable graph
+// (CsrDiGraph) built from it copies them once, into blocks with slack space.
+
+bool readCsrSnapshotCheck(const CsrSnapshotHeader& h, size_t N) {
+  if (memcmp(h.magic, CSR_SNAPSHOT_MAGIC, sizeof(h.magic))!=0) return false;
+  if (h.version!=CSR_SNAPSHOT_VERSION) return false;
+  if (h.span<0 || h.order>h.span || h.size<0 || h.components<0) return false;
+  int I = h.flags & CSR_SNAPSHOT_COMPONENTS? CSR_SNAPSHOT_SECTIONS : CSR_SNAPSHOT_COMPONENT_IDS;
+  for (int i=0; i<I; i++) {
+    if (h.offsets[i] % CSR_SNAPSHOT_ALIGN!=0) return false;
+    if (h.offsets[i] + h.bytes[i] > N) return false;
+  }
+  // Sections must hold as many entries as the header says.
+  uint64_t S = h.span, M = h.size, C = h.components;
+  if (h.bytes[CSR_SNAPSHOT_VERTICES]<S || h.bytes[CSR_SNAPSHOT_OFFSETS]<(S+1)*sizeof(size_t) || h.bytes[CSR_SNAPSHOT_EDGES]<M*sizeof(int)) return false;
+  if (I==CSR_SNAPSHOT_SECTIONS && (h.bytes[CSR_SNAPSHOT_COMPONENT_IDS]<S*sizeof(int) || h.bytes[CSR_SNAPSHOT_LEVELS]<C*sizeof(int))) return false;
+  return true;
+}
+
+
+// Offsets must not decrease (nor exceed M), and each edge key must be in [0, S).
+bool readCsrSnapshotCheckEdges(const size_t *xoff, const int *xkey, int S, size_t M) {
+  int bad = 0;
+  #pragma omp parallel for schedule(dynamic, 2048) reduction(+:bad)
+  for (int u=0; u<S; u++) {
+    if (xoff[u]>xoff[u+1] || xoff[u+1]>M) { bad++; continue; }
+    for (size_t i=xoff[u]; i<xoff[u+1]; i++)
+      if (xkey[i]<0 || xkey[i]>=S) { bad++; break; }
+  }
+  return bad==0;
+}
+
+
+// Each vertex must be in a component [0, C), and each component in a level [0, C).
+bool readCsrSnapshotCheckComponents(const uint8_t *vex, const int *cids, const int *ls, int S, int C) {
+  for (int u=0; u<S; u++) {
+    if (vex[u] && (cids[u]<0 || cids[u]>=C)) return false;
+    if (!vex[u] && cids[u]!=-1) return false;
+  }
+  for (int i=0; i<C; i++)
+    if (ls[i]<0 || ls[i]>=C) return false;
+  return true;
+}
+
+
+auto readCsrSnapshot(const char *pth) {
+  CsrSnapshot a;
+  auto m = mapFile(pth);
+  if (m->size() < sizeof(CsrSnapshotHeader)) return a;
+  const char *p = m->data();
+  const auto& h = *(const CsrSnapshotHeader*) p;
+  if (!readCsrSnapshotCheck(h, m->size())) return a;
+  int S = h.span, N = h.order;
+  size_t M = h.size;
+  auto vex  = (const uint8_t*) (p + h.offsets[CSR_SNAPSHOT_VERTICES]);
+  auto xoff = (const size_t*) (p + h.offsets[CSR_SNAPSHOT_OFFSETS]);
+  auto xkey = (const int*) (p + h.offsets[CSR_SNAPSHOT_EDGES]);
+  if (xoff[0]!=0 || xoff[S]!=M) return a;
+  if (!readCsrSnapshotCheckEdges(xoff, xkey, S, M)) return a;
+  a.graph = CsrGraph<>(m, S, N, M, vex, xoff, xkey);
+  if (h.flags & CSR_SNAPSHOT_COMPONENTS) {
+    auto cids = (const int*) (p + h.offsets[CSR_SNAPSHOT_COMPONENT_IDS]);
+    auto ls   = (const int*) (p + h.offsets[CSR_SNAPSHOT_LEVELS]);
+    if (!readCsrSnapshotCheckComponents(vex, cids, ls, S, h.components)) return a;
+    a.componentIds.assign(cids, cids+S);
+    a.levels.assign(ls, ls+h.components);
+    a.hasComponents = true;
+  }
+  a.valid = true;
+  return a;
+}
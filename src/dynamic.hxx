@@ -5,8 +5,10 @@
 #include <algorithm>
 #include "_main.hxx"
 #include "vertices.hxx"
+#include "dfs.hxx"
 #include "components.hxx"
 
+using std::pair;
 using std::vector;
 using std::unordered_set;
 using std::max;
@@ -221,3 +223,65 @@ auto dynamicComponentIndices(const G& x, const H& xt, const G& y, const H& yt, c
     affectedComponentIndicesForEach(x, xt, y, yt, cs, b, fn);
   });
 }
+
+
+
+
+// UPDATED-VERTICES
+// ----------------
+// Find vertices with edges added/removed, from a batch of edge updates.
+
+template <class G, class F>
+void updatedVerticesForEach(const G& y, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, F fn) {
+  auto fu = [&](int u) { if (y.hasVertex(u)) fn(u); };
+  for (const auto& [u, v] : deletions)  { fu(u); fu(v); }
+  for (const auto& [u, v] : insertions) { fu(u); fu(v); }
+}
+
+template <class G>
+auto updatedVertices(const G& y, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions) {
+  vector<int> a; updatedVerticesForEach(y, deletions, insertions, [&](int u) { a.push_back(u); });
+  return a;
+}
+
+
+
+
+// DYNAMIC-VERTICES (FROM UPDATES)
+// -------------------------------
+// Find affected, unaffected vertices (vertices, no. affected).
+// Affected vertices are those reachable from updated ones.
+
+template <class G>
+auto dynamicVerticesFrom(const G& y, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions) {
+  vector<int> a;
+  auto vis = createContainer(y, bool());
+  auto fn  = [&](int u) { a.push_back(u); };
+  updatedVerticesForEach(y, deletions, insertions, [&](int u) { dfsDoLoop(vis, y, u, fn); });
+  size_t n = a.size();
+  for (int u : y.vertices())
+    if (!vis[u]) a.push_back(u);
+  return make_pair(a, n);
+}
+
+
+
+
+// DYNAMIC-COMPONENTS (FROM UPDATES)
+// ---------------------------------
+// Find affected, unaffected components (components, no. affected).
+// Affected components are those reachable from updated ones.
+
+template <class B>
+auto dynamicComponentIndicesFrom(const vector2d<int>& cs, const vector<int>& cids, const B& b, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions) {
+  vector<int> a;
+  auto vis = createContainer(b, bool());
+  auto fn  = [&](int i) { a.push_back(i); };
+  auto fu  = [&](int u) { if (u<int(cids.size()) && cids[u]>=0) dfsDoLoop(vis, b, cids[u], fn); };
+  for (const auto& [u, v] : deletions)  { fu(u); fu(v); }
+  for (const auto& [u, v] : insertions) { fu(u); fu(v); }
+  size_t n = a.size();
+  for (int i=0, I=cs.size(); i<I; ++i)
+    if (!vis[i] && !cs[i].empty()) a.push_back(i);
+  return make_pair(a, n);
+}
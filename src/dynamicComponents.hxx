@@ -0,0 +1,331 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include "_main.hxx"
+#include "vertices.hxx"
+#include "components.hxx"
+
+using std::pair;
+using std::vector;
+using std::deque;
+using std::unordered_map;
+using std::unordered_set;
+using std::max;
+using std::move;
+using std::swap;
+
+
+
+
+// COMPONENTS-AT
+// -------------
+// Finds SCCs of the subgraph induced by given vertices (Kosaraju).
+
+template <class G, class FI, class F>
+void componentsAtDfsLoop(vector<bool>& vis, const G& x, const vector<int>& ks, FI fi, int i, F fn) {
+  if (vis[i]) return;  // dont visit if done already!
+  vis[i] = true; fn(i);
+  for (int v : x.edges(ks[i])) {
+    int j = fi(v);
+    if (j>=0 && !vis[j]) componentsAtDfsLoop(vis, x, ks, fi, j, fn);
+  }
+}
+
+template <class G, class FI>
+void componentsAtDfsEndLoop(vector<int>& a, vector<bool>& vis, const G& x, const vector<int>& ks, FI fi, int i) {
+  if (vis[i]) return;  // dont visit if done already!
+  vis[i] = true;
+  for (int v : x.edges(ks[i])) {
+    int j = fi(v);
+    if (j>=0 && !vis[j]) componentsAtDfsEndLoop(a, vis, x, ks, fi, j);
+  }
+  a.push_back(i);
+}
+
+
+template <class G, class H, class FI>
+auto componentsAtBy(const G& x, const H& xt, const vector<int>& ks, FI fi) {
+  vector2d<int> a;
+  vector<int> vs;
+  int K = ks.size();
+  // original dfs
+  vector<bool> vis(K);
+  for (int i=0; i<K; i++)
+    if (!vis[i]) componentsAtDfsEndLoop(vs, vis, x, ks, fi, i);
+  // transpose dfs
+  fill(vis, false);
+  while (!vs.empty()) {
+    int i = vs.back(); vs.pop_back();
+    if (vis[i]) continue;
+    a.push_back(vector<int>());
+    componentsAtDfsLoop(vis, xt, ks, fi, i, [&](int j) { a.back().push_back(ks[j]); });
+  }
+  return a;
+}
+
+template <class G, class H>
+auto componentsAt(const G& x, const H& xt, const vector<int>& ks) {
+  int K = ks.size();
+  // Dense index for large subgraphs, sparse otherwise.
+  if (K >= x.span()/16) {
+    vector<int> is(x.span(), -1);
+    for (int i=0; i<K; i++)
+      is[ks[i]] = i;
+    return componentsAtBy(x, xt, ks, [&](int v) { return is[v]; });
+  }
+  unordered_map<int, int> is;
+  for (int i=0; i<K; i++)
+    is[ks[i]] = i;
+  return componentsAtBy(x, xt, ks, [&](int v) { auto it = is.find(v); return it!=is.end()? it->second : -1; });
+}
+
+
+
+
+// REACHABLE-IN-COMPONENT
+// ----------------------
+// Is v reachable from u, going only through vertices of component c?
+// Searches both ways (x from u, xt from v), expanding the smaller frontier.
+
+template <class G>
+bool reachableInComponentStep(vector<int>& us, unordered_set<int>& vis, const unordered_set<int>& wis, const G& x, const vector<int>& cids, int c) {
+  vector<int> vs;
+  for (int u : us) {
+    for (int v : x.edges(u)) {
+      if (cids[v]!=c || vis.count(v)>0) continue;
+      if (wis.count(v)>0) return true;
+      vis.insert(v); vs.push_back(v);
+    }
+  }
+  swap(us, vs);
+  return false;
+}
+
+template <class G, class H>
+bool reachableInComponent(const G& x, const H& xt, const vector<int>& cids, int c, int u, int v) {
+  if (u==v) return true;
+  unordered_set<int> uvis {u}, vvis {v};
+  vector<int> us {u}, vs {v};
+  while (!us.empty() && !vs.empty()) {
+    if (us.size() <= vs.size()) { if (reachableInComponentStep(us, uvis, vvis, x,  cids, c)) return true; }
+    else                        { if (reachableInComponentStep(vs, vvis, uvis, xt, cids, c)) return true; }
+  }
+  return false;
+}
+
+
+
+
+// COMPONENT-LEVELS
+// ----------------
+// Update levelwise group index of components whose in-edges changed.
+
+template <class B>
+void updateComponentLevels(vector<int>& ls, const B& b, const B& bt, vector<int>& qs) {
+  deque<int> us(qs.begin(), qs.end()); qs.clear();
+  while (!us.empty()) {
+    int c = us.front(); us.pop_front();
+    if (!bt.hasVertex(c)) continue;
+    int l = 0;
+    for (int p : bt.edges(c))
+      l = max(l, ls[p]+1);
+    if (ls[c]==l) continue;
+    ls[c] = l;
+    for (int d : b.edges(c))
+      us.push_back(d);
+  }
+}
+
+
+
+
+// UPDATE-COMPONENTS
+// -----------------
+// Update components, blockgraph, and levels with a batch of edge updates.
+// Components, blockgraph (+transpose), and levels must match old graph (x).
+// Updated graph (y) must already have deletions, insertions applied.
+
+template <class B>
+void addBlockEdge(B& b, B& bt, int c, int d, vector<int>& qs) {
+  if (b.hasEdge(c, d)) return;
+  b.addEdgeChecked(c, d);
+  bt.addEdgeChecked(d, c);
+  qs.push_back(d);
+}
+
+template <class B>
+void removeBlockEdge(B& b, B& bt, int c, int d, vector<int>& qs) {
+  if (!b.hasEdge(c, d)) return;
+  b.removeEdge(c, d);
+  bt.removeEdge(d, c);
+  qs.push_back(d);
+}
+
+
+template <class B>
+int addBlockComponent(vector2d<int>& cs, B& b, B& bt, vector<int>& ls, vector<int>&& ks) {
+  int c = cs.size();
+  cs.push_back(move(ks));
+  b.addVertex(c);
+  bt.addVertex(c);
+  ls.push_back(0);
+  return c;
+}
+
+
+// Components on a cycle through new block edge c->d (empty if none).
+template <class B>
+auto blockCycleComponents(const vector<int>& ls, const B& b, const B& bt, int c, int d) {
+  unordered_set<int> fwd, a;
+  vector<int> us {d};
+  if (ls[c] < ls[d]) return a;  // levels increase along each path
+  // Components reachable from d, not beyond level of c.
+  fwd.insert(d);
+  while (!us.empty()) {
+    int u = us.back(); us.pop_back();
+    for (int v : b.edges(u)) {
+      if (ls[v] > ls[c] || fwd.count(v)>0) continue;
+      fwd.insert(v); us.push_back(v);
+    }
+  }
+  if (fwd.count(c)==0) return a;
+  // Of them, components that reach c.
+  a.insert(c); us.push_back(c);
+  while (!us.empty()) {
+    int u = us.back(); us.pop_back();
+    for (int v : bt.edges(u)) {
+      if (fwd.count(v)==0 || a.count(v)>0) continue;
+      a.insert(v); us.push_back(v);
+    }
+  }
+  return a;
+}
+
+
+// Merge components into the largest one, returning its index.
+template <class B>
+int mergeBlockComponents(vector2d<int>& cs, vector<int>& cids, B& b, B& bt, const unordered_set<int>& ms, vector<int>& qs) {
+  vector<int> es;
+  int t = *ms.begin();
+  for (int m : ms)
+    if (cs[m].size() > cs[t].size()) t = m;
+  for (int m : ms) {
+    if (m==t) continue;
+    // Move edges of m to t.
+    es.clear(); append(es, b.edges(m));
+    for (int d : es) {
+      removeBlockEdge(b, bt, m, d, qs);
+      if (ms.count(d)==0) addBlockEdge(b, bt, t, d, qs);
+    }
+    es.clear(); append(es, bt.edges(m));
+    for (int p : es) {
+      removeBlockEdge(b, bt, p, m, qs);
+      if (ms.count(p)==0) addBlockEdge(b, bt, p, t, qs);
+    }
+    // Move vertices of m to t.
+    for (int u : cs[m])
+      cids[u] = t;
+    append(cs[t], cs[m]);
+    cs[m] = vector<int>();
+    b.removeIsolatedVertex(m);
+    bt.removeIsolatedVertex(m);
+  }
+  // Remove edges within merged component.
+  es.clear(); append(es, b.edges(t));
+  for (int d : es)
+    if (ms.count(d)>0) removeBlockEdge(b, bt, t, d, qs);
+  es.clear(); append(es, bt.edges(t));
+  for (int p : es)
+    if (ms.count(p)>0) removeBlockEdge(b, bt, p, t, qs);
+  qs.push_back(t);
+  return t;
+}
+
+
+// Split a component into its SCCs in updated graph, if needed.
+template <class G, class H, class B>
+void splitBlockComponent(vector2d<int>& cs, vector<int>& cids, B& b, B& bt, vector<int>& ls, const G& y, const H& yt, int c, vector<int>& qs) {
+  auto ps = componentsAt(y, yt, cs[c]);
+  if (ps.size()<=1) return;
+  vector<int> es;
+  // Drop old edges of component.
+  es.clear(); append(es, b.edges(c));
+  for (int d : es)
+    removeBlockEdge(b, bt, c, d, qs);
+  es.clear(); append(es, bt.edges(c));
+  for (int p : es)
+    removeBlockEdge(b, bt, p, c, qs);
+  // First part keeps the index, others get new ones.
+  vector<int> is {c};
+  cs[c] = move(ps[0]);
+  for (size_t i=1; i<ps.size(); ++i)
+    is.push_back(addBlockComponent(cs, b, bt, ls, move(ps[i])));
+  for (int i : is) {
+    for (int u : cs[i])
+      cids[u] = i;
+  }
+  // Add new edges of each part.
+  for (int i : is) {
+    for (int u : cs[i]) {
+      for (int v : y.edges(u))
+        if (cids[v]!=i) addBlockEdge(b, bt, i, cids[v], qs);
+      for (int v : yt.edges(u))
+        if (cids[v]!=i) addBlockEdge(b, bt, cids[v], i, qs);
+    }
+    qs.push_back(i);
+  }
+}
+
+
+// Is there any edge from component c to d in updated graph?
+template <class G, class H>
+bool hasBlockEdge(const G& y, const H& yt, const vector2d<int>& cs, const vector<int>& cids, int c, int d) {
+  if (cs[c].size() <= cs[d].size()) {
+    for (int u : cs[c]) {
+      for (int v : y.edges(u))
+        if (cids[v]==d) return true;
+    }
+  }
+  else {
+    for (int v : cs[d]) {
+      for (int u : yt.edges(v))
+        if (cids[u]==c) return true;
+    }
+  }
+  return false;
+}
+
+
+template <class G, class H, class B>
+void updateComponents(vector2d<int>& cs, vector<int>& cids, B& b, B& bt, vector<int>& ls, const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions) {
+  vector<int> qs;
+  if (int(cids.size()) < y.span()) cids.resize(y.span(), -1);
+  // Insertions: new vertices become components, cycles merge components.
+  for (const auto& [u, v] : insertions) {
+    if (!y.hasEdge(u, v)) continue;
+    if (cids[u]<0) cids[u] = addBlockComponent(cs, b, bt, ls, {u});
+    if (cids[v]<0) cids[v] = addBlockComponent(cs, b, bt, ls, {v});
+    int c = cids[u], d = cids[v];
+    if (c==d || b.hasEdge(c, d)) continue;
+    auto ms = blockCycleComponents(ls, b, bt, c, d);
+    addBlockEdge(b, bt, c, d, qs);
+    if (!ms.empty()) mergeBlockComponents(cs, cids, b, bt, ms, qs);
+    updateComponentLevels(ls, b, bt, qs);
+  }
+  // Deletions: drop unused block edges, split components which lost a cycle.
+  unordered_set<int> splits;
+  for (const auto& [u, v] : deletions) {
+    if (y.hasEdge(u, v) || u>=int(cids.size()) || v>=int(cids.size())) continue;
+    int c = cids[u], d = cids[v];
+    if (c<0 || d<0) continue;
+    if (c!=d) { if (!hasBlockEdge(y, yt, cs, cids, c, d)) removeBlockEdge(b, bt, c, d, qs); }
+    else if (splits.count(c)==0 && !reachableInComponent(y, yt, cids, c, u, v)) splits.insert(c);
+  }
+  for (int c : splits)
+    splitBlockComponent(cs, cids, b, bt, ls, y, yt, c, qs);
+  updateComponentLevels(ls, b, bt, qs);
+}
@@ -3,9 +3,11 @@
 #include <iterator>
 #include <algorithm>
 #include <random>
+#include <utility>
 #include "_main.hxx"
 
 using std::vector;
+using std::make_pair;
 using std::uniform_real_distribution;
 using std::transform;
 using std::back_inserter;
@@ -143,6 +145,31 @@ void addRandomEdgeByDegree(G& a, R& rnd, int span) {
 
 
 
+// RANDOM-EDGE
+// -----------
+// Pick a random existing edge ({-1, -1} if none).
+
+template <class G, class R>
+auto randomEdge(const G& x, R& rnd, int u) {
+  uniform_real_distribution<> dis(0.0, 1.0);
+  if (x.degree(u) == 0) return make_pair(-1, -1);
+  int vi = int(dis(rnd) * x.degree(u)), i = 0;
+  for (int v : x.edges(u))
+    if (i++ == vi) return make_pair(u, v);
+  return make_pair(-1, -1);
+}
+
+
+template <class G, class R>
+auto randomEdge(const G& x, R& rnd) {
+  uniform_real_distribution<> dis(0.0, 1.0);
+  int u = int(dis(rnd) * x.span());
+  return randomEdge(x, rnd, u);
+}
+
+
+
+
 // REMOVE-RANDOM-EDGE
 // ------------------
 
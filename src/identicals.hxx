@@ -27,7 +27,7 @@ auto edgeIdenticalsFromSize(const G& x, const J& ks, int n) {
   vector2d<int> a;
   for (auto& p : m) {
     auto& is = p.second;
-    if (is.size()<n) continue;
+    if (int(is.size())<n) continue;
     sort(is); a.push_back(move(is));
   }
   return a;
@@ -1,10 +1,13 @@
 #pragma once
 #include "_main.hxx"
 #include "DiGraph.hxx"
+#include "CsrGraph.hxx"
+#include "CsrDiGraph.hxx"
 #include "vertices.hxx"
 #include "edges.hxx"
 #include "csr.hxx"
 #include "snap.hxx"
+#include "temporal.hxx"
 #include "mtx.hxx"
 #include "copy.hxx"
 #include "transpose.hxx"
@@ -12,19 +15,26 @@
 #include "selfLoop.hxx"
 #include "components.hxx"
 #include "sort.hxx"
+#include "order.hxx"
 #include "identicals.hxx"
 #include "dynamic.hxx"
+#include "dynamicComponents.hxx"
 #include "pagerank.hxx"
+#include "csrSnapshot.hxx"
 #include "pagerankSeq.hxx"
 #include "pagerankOmp.hxx"
-#include "pagerankCuda.hxx"
 // #include "pagerankNvgraph.hxx"
 #include "pagerankMonolithicSeq.hxx"
 #include "pagerankMonolithicOmp.hxx"
-#include "pagerankMonolithicCuda.hxx"
 #include "pagerankComponentwiseSeq.hxx"
 #include "pagerankComponentwiseOmp.hxx"
-#include "pagerankComponentwiseCuda.hxx"
 #include "pagerankLevelwiseSeq.hxx"
 #include "pagerankLevelwiseOmp.hxx"
+#include "pagerankTaskwiseOmp.hxx"
+#include "pagerankCompress.hxx"
+#ifdef __CUDACC__
+#include "pagerankCuda.hxx"
+#include "pagerankMonolithicCuda.hxx"
+#include "pagerankComponentwiseCuda.hxx"
 #include "pagerankLevelwiseCuda.hxx"
+#endif
@@ -6,6 +6,8 @@
 #include <algorithm>
 #include "_main.hxx"
 #include "DiGraph.hxx"
+#include "CsrGraph.hxx"
+#include "csr.hxx"
 
 using std::string;
 using std::istream;
@@ -13,6 +15,114 @@ using std::stringstream;
 using std::ofstream;
 using std::getline;
 using std::max;
+using std::min;
+using std::move;
+
+
+
+
+// READ-MTX-CSR
+// ------------
+// Parallel reader: memory-maps the file, parses chunks of lines
+// on all threads, and builds CSR directly (no per-edge allocation).
+
+const char* readMtxSkipLine(const char *p, const char *e) {
+  while (p<e && *p!='\n') ++p;
+  return p<e? p+1 : e;
+}
+
+const char* readMtxInt(int& a, const char *p, const char *e) {
+  while (p<e && (*p==' ' || *p=='\t')) ++p;
+  if (p>=e || *p<'0' || *p>'9') { a = -1; return p; }
+  for (a=0; p<e && *p>='0' && *p<='9'; ++p)
+    a = a*10 + (*p-'0');
+  return p;
+}
+
+
+// Find start of lines in each chunk of text.
+auto readMtxChunks(const char *b, const char *e, int P) {
+  vector<const char*> a(P+1, e);
+  size_t n = e-b;
+  a[0] = b;
+  for (int t=1; t<P; t++) {
+    const char *p = max(a[t-1], b + n*t/P);
+    a[t] = p==b || p[-1]=='\n'? p : readMtxSkipLine(p, e);
+  }
+  return a;
+}
+
+
+// Parse edges into per-chunk lists, returns no. of rows/cols (-1 if bad).
+int readMtxEdgesOmp(vector2d<int>& us, vector2d<int>& vs, const char *b, const char *e, int P) {
+  string ln, h0, h1, h2, h3, h4;
+  const char *p = b;
+  // read header
+  while (p<e) {
+    const char *q = readMtxSkipLine(p, e);
+    ln.assign(p, q); p = q;
+    if (ln.find('%')!=0) break;
+    if (ln.find("%%")!=0) continue;
+    stringstream ls(ln);
+    ls >> h0 >> h1 >> h2 >> h3 >> h4;
+  }
+  if (h1!="matrix" || h2!="coordinate") return -1;
+  bool sym = h4=="symmetric" || h4=="skew-symmetric";
+  // read rows, cols, size
+  int r, c; size_t sz;
+  stringstream ls(ln);
+  if (!(ls >> r >> c >> sz)) return -1;
+  // read edges (from, to)
+  auto ps = readMtxChunks(p, e, P);
+  us.resize(P); vs.resize(P);
+  #pragma omp parallel for schedule(static, 1)
+  for (int t=0; t<P; t++) {
+    const char *q = ps[t], *qe = ps[t+1];
+    us[t].reserve(sz/P + 1);
+    vs[t].reserve(sz/P + 1);
+    while (q<qe) {
+      int u, v;
+      if (*q=='%') { q = readMtxSkipLine(q, qe); continue; }
+      q = readMtxInt(u, q, qe);
+      q = readMtxInt(v, q, qe);
+      q = readMtxSkipLine(q, qe);
+      if (u<0 || v<0) continue;
+      us[t].push_back(u); vs[t].push_back(v);
+      if (sym) { us[t].push_back(v); vs[t].push_back(u); }
+    }
+  }
+  return max(r, c);
+}
+
+
+auto readMtxCsr(const char *pth) {
+  auto f = mapFile(pth);
+  int  P = omp_get_max_threads();
+  vector2d<int> us, vs;
+  int  n = f->empty()? -1 : readMtxEdgesOmp(us, vs, f->data(), f->data()+f->size(), P);
+  if (n<0) return CsrGraph<>();
+  // vertices are 1 to n (and any beyond, as with DiGraph)
+  int S = n+1;
+  #pragma omp parallel for schedule(static, 1) reduction(max:S)
+  for (int t=0; t<P; t++) {
+    for (int u : us[t]) S = max(S, u+1);
+    for (int v : vs[t]) S = max(S, v+1);
+  }
+  vector<uint8_t> vex(S);
+  for (int u=1; u<=n; u++)
+    vex[u] = 1;
+  auto [offs, keys] = csrFromEdgesOmp(S, P, [&](int t, auto fn) {
+    for (size_t i=0, I=us[t].size(); i<I; ++i)
+      fn(us[t][i], vs[t][i]);
+  });
+  for (int u=n+1; u<S; u++)
+    if (offs[u+1]>offs[u]) vex[u] = 1;
+  if (S>n+1) {
+    for (int v : keys)
+      vex[v] = 1;
+  }
+  return CsrGraph<>(move(vex), move(offs), move(keys));
+}
 
 
 
@@ -36,7 +146,7 @@ void readMtx(G& a, istream& s) {
   bool sym = h4=="symmetric" || h4=="skew-symmetric";
 
   // read rows, cols, size
-  int r, c, sz;
+  int r, c; size_t sz;
   stringstream ls(ln);
   ls >> r >> c >> sz;
   int n = max(r, c);
@@ -60,11 +170,17 @@ auto readMtx(istream& s) {
 }
 
 
+// File is parsed in parallel (see readMtxCsr), and then added to the graph.
 template <class G>
 void readMtx(G& a, const char *pth) {
-  string buf = readFile(pth);
-  stringstream s(buf);
-  return readMtx(a, s);
+  auto x = readMtxCsr(pth);
+  for (int u : x.vertices())
+    a.addVertex(u);
+  for (int u : x.vertices()) {
+    for (int v : x.edges(u))
+      a.addEdge(u, v);
+  }
+  a.correct();
 }
 
 auto readMtx(const char *pth) {
@@ -0,0 +1,100 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "_main.hxx"
+
+using std::vector;
+using std::stable_sort;
+using std::reverse;
+using std::copy;
+
+
+
+
+// VERTEX-ORDER
+// ------------
+// Order in which vertices are processed (and stored, for CSR copies).
+
+enum VertexOrder {
+  ORDER_NONE = 0,
+  ORDER_DEGREE,     // by out-degree, high first
+  ORDER_RCM,        // Reverse Cuthill-McKee
+  ORDER_COMPONENT   // by SCC, RCM within each
+};
+
+
+
+
+// DEGREE-ORDER
+// ------------
+// Vertices with many out-edges (contributions read often) come first.
+
+template <class G>
+void degreeOrder(vector<int>& ks, int i, int n, const G& x) {
+  stable_sort(ks.begin()+i, ks.begin()+i+n, [&](int u, int v) { return x.degree(u) > x.degree(v); });
+}
+
+
+
+
+// RCM-ORDER
+// ---------
+// Reverse Cuthill-McKee (BFS from low degree vertices, both edge directions).
+// Only vertices marked in (vin) are visited, and their marks are cleared.
+
+template <class G, class H>
+void rcmOrderMarked(vector<int>& ks, int i, int n, vector<uint8_t>& vin, const G& x, const H& xt) {
+  auto fd = [&](int u) { return x.degree(u) + xt.degree(u); };
+  auto fl = [&](int u, int v) { return fd(u) < fd(v); };
+  vector<int> ss(ks.begin()+i, ks.begin()+i+n), a, vs;
+  stable_sort(ss.begin(), ss.end(), fl);
+  for (int s : ss) {
+    if (!vin[s]) continue;
+    size_t j = a.size();
+    a.push_back(s); vin[s] = 0;
+    for (; j<a.size(); ++j) {
+      int u = a[j]; vs.clear();
+      for (int v : x.edges(u))
+        if (vin[v]) { vin[v] = 0; vs.push_back(v); }
+      for (int v : xt.edges(u))
+        if (vin[v]) { vin[v] = 0; vs.push_back(v); }
+      stable_sort(vs.begin(), vs.end(), fl);
+      a.insert(a.end(), vs.begin(), vs.end());
+    }
+  }
+  reverse(a.begin(), a.end());
+  copy(a.begin(), a.end(), ks.begin()+i);
+}
+
+template <class G, class H>
+void rcmOrder(vector<int>& ks, int i, int n, const G& x, const H& xt) {
+  vector<uint8_t> vin(x.span());
+  for (int j=i; j<i+n; j++)
+    vin[ks[j]] = 1;
+  rcmOrderMarked(ks, i, n, vin, x, xt);
+}
+
+
+
+
+// COMPONENT-ORDER
+// ---------------
+// Vertices grouped by SCC (in order of component id), RCM within each.
+// Marks (vin) must be clear, and are left clear.
+
+template <class G, class H>
+void componentOrderMarked(vector<int>& ks, int i, int n, vector<uint8_t>& vin, const G& x, const H& xt, const vector<int>& cids) {
+  stable_sort(ks.begin()+i, ks.begin()+i+n, [&](int u, int v) { return cids[u] < cids[v]; });
+  for (int j=i, J=i; j<i+n; j=J) {
+    for (J=j; J<i+n && cids[ks[J]]==cids[ks[j]]; J++)
+      vin[ks[J]] = 1;
+    rcmOrderMarked(ks, j, J-j, vin, x, xt);
+  }
+}
+
+template <class G, class H>
+void componentOrder(vector<int>& ks, int i, int n, const G& x, const H& xt, const vector<int>& cids) {
+  vector<uint8_t> vin(x.span());
+  componentOrderMarked(ks, i, n, vin, x, xt, cids);
+}
@@ -2,7 +2,12 @@
 #include <vector>
 #include <utility>
 #include "_main.hxx"
+#include "transpose.hxx"
+#include "components.hxx"
+#include "sort.hxx"
+#include "dynamicComponents.hxx"
 
+using std::pair;
 using std::vector;
 using std::move;
 
@@ -50,6 +55,10 @@ constexpr int MIN_COMPUTE_PR()  noexcept { return 1000000; }  // 10
 template <class T=float>
 constexpr int MIN_COMPUTE_PRC() noexcept { return 1000000; }  // 5000000
 
+// For taskwise pagerank (vertices + in-edges, to split a component)
+template <class T=float>
+constexpr int MIN_SPLIT_PR() noexcept { return 32768; }
+
 
 
 
@@ -65,9 +74,27 @@ struct PagerankOptions {
   T    damping;
   T    tolerance;
   int  maxIterations;
+  T    frontierTolerance;  // relative rank change to expand dynamic frontier
+  int  vertexOrder;        // see VertexOrder
+  int  edgeFormat;         // see EdgeFormat
 
-  PagerankOptions(int repeat=1, int toleranceNorm=3, int minCompute=1, bool splitComponents=false, T damping=0.85, T tolerance=1e-10, int maxIterations=500) :
-  repeat(repeat), toleranceNorm(toleranceNorm), minCompute(minCompute), splitComponents(splitComponents), damping(damping), tolerance(tolerance), maxIterations(maxIterations) {}
+  PagerankOptions(int repeat=1, int toleranceNorm=3, int minCompute=1, bool splitComponents=false, T damping=0.85, T tolerance=1e-10, int maxIterations=500, T frontierTolerance=1e-6, int vertexOrder=0, int edgeFormat=0) :
+  repeat(repeat), toleranceNorm(toleranceNorm), minCompute(minCompute), splitComponents(splitComponents), damping(damping), tolerance(tolerance), maxIterations(maxIterations), frontierTolerance(frontierTolerance), vertexOrder(vertexOrder), edgeFormat(edgeFormat) {}
+};
+
+
+
+
+// PAGERANK-PHASES
+// ---------------
+// Time spent in each phase of a pagerank call (ms, averaged over repeats).
+// Finding components / affected vertices is the rest of the call.
+
+struct PagerankPhases {
+  float csr        = 0;  // flattened CSR copy (and old ranks in its order)
+  float initialize = 0;  // initial ranks, factors, contributions
+  float iterate    = 0;  // rank computation
+  float decompress = 0;  // ranks back in vertex order
 };
 
 
@@ -81,12 +108,13 @@ struct PagerankResult {
   vector<T> ranks;
   int   iterations;
   float time;
+  PagerankPhases phases;
 
-  PagerankResult(vector<T>&& ranks, int iterations=0, float time=0) :
-  ranks(ranks), iterations(iterations), time(time) {}
+  PagerankResult(vector<T>&& ranks, int iterations=0, float time=0, PagerankPhases phases={}) :
+  ranks(ranks), iterations(iterations), time(time), phases(phases) {}
 
-  PagerankResult(vector<T>& ranks, int iterations=0, float time=0) :
-  ranks(move(ranks)), iterations(iterations), time(time) {}
+  PagerankResult(vector<T>& ranks, int iterations=0, float time=0, PagerankPhases phases={}) :
+  ranks(move(ranks)), iterations(iterations), time(time), phases(phases) {}
 
 
   // Get initial ranks (when no vertices affected for dynamic pagerank).
@@ -111,19 +139,67 @@ struct PagerankData {
   G blockgraph;
   G blockgraphTranspose;
   vector2d<int> components;
+  vector<int> componentIds;  // component of each vertex
+  vector<int> levels;        // levelwise group index of each component
 };
 
+
+// Find all pagerank data of a graph.
+template <class G, class H>
+auto pagerankData(const G& x, const H& xt) {
+  auto cs = components(x, xt);
+  auto b  = blockgraph(x, cs);
+  auto bt = transpose(b);
+  auto ci = componentIds(x, cs);
+  auto ls = levelwiseGroupIndices(bt);
+  return PagerankData<G> {move(b), move(bt), move(cs), move(ci), move(ls)};
+}
+
+
+// Rebuild pagerank data from cached component ids, levels (no SCC search).
 template <class G>
-auto blockgraphD(const G& x, const vector2d<int>& cs, const PagerankData<G> *D) {
-  return D? D->blockgraph : blockgraph(x, cs);
+auto pagerankDataFrom(const G& x, const vector<int>& componentIds, const vector<int>& levels) {
+  vector2d<int> cs(levels.size());
+  for (int u : x.vertices())
+    cs[componentIds[u]].push_back(u);
+  auto b  = blockgraph(x, cs);
+  auto bt = transpose(b);
+  return PagerankData<G> {move(b), move(bt), move(cs), componentIds, levels};
+}
+
+
+// Update pagerank data with a batch of edge deletions, insertions.
+// Components are merged/split locally, instead of being found again.
+// @param D pagerank data of old graph (updated in-place)
+// @param y updated graph (with deletions, insertions applied)
+// @param yt transpose of updated graph
+template <class G, class H>
+void updatePagerankData(PagerankData<G>& D, const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions) {
+  updateComponents(D.components, D.componentIds, D.blockgraph, D.blockgraphTranspose, D.levels, y, yt, deletions, insertions);
+}
+
+// Use pagerank data of D if given (no copy), or find it into buffer (Dx).
+template <class G>
+const G& blockgraphD(PagerankData<G>& Dx, const G& x, const vector2d<int>& cs, const PagerankData<G> *D) {
+  return D? D->blockgraph : (Dx.blockgraph = blockgraph(x, cs));
+}
+
+template <class G>
+const G& blockgraphTransposeD(PagerankData<G>& Dx, const G& b, const PagerankData<G> *D) {
+  return D? D->blockgraphTranspose : (Dx.blockgraphTranspose = transpose(b));
+}
+
+template <class G, class H>
+const vector2d<int>& componentsD(PagerankData<G>& Dx, const G& x, const H& xt, const PagerankData<G> *D) {
+  return D? D->components : (Dx.components = components(x, xt));
 }
 
 template <class G>
-auto blockgraphTransposeD(const G& b, const PagerankData<G> *D) {
-  return D? D->blockgraphTranspose : transpose(b);
+const vector<int>& componentIdsD(PagerankData<G>& Dx, const G& x, const vector2d<int>& cs, const PagerankData<G> *D) {
+  return D? D->componentIds : (Dx.componentIds = componentIds(x, cs));
 }
 
 template <class G, class H>
-auto componentsD(const G& x, const H& xt, const PagerankData<G> *D) {
-  return D? D->components : components(x, xt);
+const vector<int>& levelwiseGroupIndicesD(PagerankData<G>& Dx, const H& bt, const PagerankData<G> *D) {
+  return D? D->levels : (Dx.levels = levelwiseGroupIndices(bt));
 }
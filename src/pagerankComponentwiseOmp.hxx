@@ -22,13 +22,13 @@ using std::swap;
 // PAGERANK-LOOP
 // -------------
 
-template <class T, class J>
-float pagerankComponentwiseOmpLoop(vector<T>& a, vector<T>& r, vector<T>& c, const vector<T>& f, const vector<int>& vfrom, const vector<int>& efrom, int i, const J& ns, int N, T p, T E, int L, int EF) {
+template <class T, class J, class C>
+float pagerankComponentwiseOmpLoop(vector<T>& a, vector<T>& r, vector<T>& c, vector<T>& cn, const vector<T>& f, const C& xc, int i, const J& ns, int N, T p, T E, int L, int EF) {
   float t = 0;
   for (int n : ns) {
     if (n<=0) { i += -n; continue; }
     T np = T(n)/N, En = EF<=2? E*n/N : E;
-    t += pagerankMonolithicOmpLoop(a, r, c, f, vfrom, efrom, i, n, N, p, En, L, EF);
+    t += pagerankMonolithicOmpLoop(a, r, c, cn, f, xc, i, n, N, p, En, L, EF);
     swap(a, r);
     i += n;
   }
@@ -36,6 +36,12 @@ float pagerankComponentwiseOmpLoop(vector<T>& a, vector<T>& r, vector<T>& c, con
   return t;
 }
 
+// Loop for in-edges in any format (see EdgeFormat).
+template <class T>
+auto pagerankComponentwiseOmpLoopFn() {
+  return [](auto&... args) { return pagerankComponentwiseOmpLoop<T>(args...); };
+}
+
 
 
 
@@ -57,7 +63,7 @@ PagerankResult<T> pagerankComponentwiseOmp(const G& x, const H& xt, const vector
   auto gs = joinUntilSize<int>(ds, o.minCompute);
   auto ns = transformIter(gs, [&](const auto& c) { return c.size(); });
   auto ks = join<int>(gs);
-  return pagerankOmp(xt, ks, 0, ns, pagerankComponentwiseOmpLoop<T, decltype(ns)>, q, o);
+  return pagerankOmp(xt, ks, 0, ns, pagerankComponentwiseOmpLoopFn<T>(), q, o);
 }
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankComponentwiseOmp(const G& x, const H& xt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}) {
@@ -87,7 +93,7 @@ PagerankResult<T> pagerankComponentwiseOmpDynamic(const G& x, const H& xt, const
   auto gs = joinAtUntilSize<int>(ds, sliceIter(is, 0, n), o.minCompute);
   auto ns = transformIter(gs, [&](const auto& g) { return g.size(); });
   auto ks = join<int>(gs); joinAt(ks, ds, sliceIter(is, n));
-  return pagerankOmp(yt, ks, 0, ns, pagerankComponentwiseOmpLoop<T, decltype(ns)>, q, o);
+  return pagerankOmp(yt, ks, 0, ns, pagerankComponentwiseOmpLoopFn<T>(), q, o);
 }
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankComponentwiseOmpDynamic(const G& x, const H& xt, const G& y, const H& yt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}) {
@@ -0,0 +1,349 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include <climits>
+#include <algorithm>
+#include "_main.hxx"
+#include "vertices.hxx"
+#include "edges.hxx"
+#include "chains.hxx"
+#include "identicals.hxx"
+#include "CsrDiGraph.hxx"
+#include "pagerank.hxx"
+#include "pagerankOmp.hxx"
+
+using std::pair;
+using std::vector;
+using std::swap;
+using std::move;
+using std::sort;
+using std::find;
+using std::unique;
+using std::any_of;
+using std::none_of;
+
+
+
+
+// PAGERANK-COMPRESSION
+// --------------------
+// Vertices that need not be iterated upon.
+// In-identical vertices (same in-edges) have the same rank as a representative,
+// and interior vertices of chains (in, out-degree 1) have a rank given by the
+// rank of the chain head (closed form). Emptied groups / chains are kept (empty).
+
+struct PagerankCompression {
+  vector2d<int> identicals;  // groups of in-identical vertices
+  vector2d<int> chains;      // interior vertices of each chain (in order)
+  vector<int> identicalIds;  // group of each vertex (-1 if none)
+  vector<int> chainIds;      // chain of each vertex (-1 if none)
+  size_t removedVertices = 0;
+  size_t removedEdges    = 0;
+};
+
+
+template <class G, class H, class J>
+void pagerankCompressChains(PagerankCompression& a, const G& x, const H& xt, const J& ks) {
+  vector<int> is;
+  auto fi = [&](int u) { return x.degree(u)==1 && xt.degree(u)==1; };
+  auto fs = [&](int u) { return a.chainIds[u]>=0 || a.identicalIds[u]>=0; };
+  for (const auto& b : chainsFromSize(x, xt, ks, 1)) {
+    is.clear();
+    for (int u : b)
+      if (fi(u)) is.push_back(u);
+    if (is.empty() || any_of(is.begin(), is.end(), fs)) continue;
+    int h = edge(xt, is.front());
+    if (fi(h) || a.chainIds[h]>=0) continue;  // cycle, or head in a chain
+    int c = a.chains.size();
+    for (int u : is)
+      a.chainIds[u] = c;
+    a.chains.push_back(is);
+  }
+}
+
+
+template <class H, class J>
+void pagerankCompressIdenticals(PagerankCompression& a, const H& xt, const J& ks) {
+  for (auto& g : edgeIdenticalsFromSize(xt, ks, 2)) {
+    int c = a.identicals.size();
+    for (int u : g)
+      a.identicalIds[u] = c;
+    a.identicals.push_back(move(g));
+  }
+}
+
+
+template <class H>
+void pagerankCompressCount(PagerankCompression& a, const H& xt) {
+  a.removedVertices = 0;
+  a.removedEdges    = 0;
+  for (const auto& g : a.identicals) {
+    if (g.empty()) continue;
+    a.removedVertices += g.size()-1;
+    a.removedEdges    += (g.size()-1) * xt.degree(g[0]);
+  }
+  for (const auto& c : a.chains) {
+    a.removedVertices += c.size();
+    a.removedEdges    += c.size();
+  }
+}
+
+
+// Find compressible vertices of a graph.
+// @param x  original graph
+// @param xt transpose graph
+template <class G, class H>
+auto pagerankCompression(const G& x, const H& xt) {
+  PagerankCompression a;
+  a.identicalIds.assign(x.span(), -1);
+  a.chainIds.assign(x.span(), -1);
+  pagerankCompressChains(a, x, xt, x.vertices());
+  vector<int> ks;
+  for (int u : x.vertices())
+    if (a.chainIds[u]<0) ks.push_back(u);
+  pagerankCompressIdenticals(a, xt, ks);
+  pagerankCompressCount(a, xt);
+  return a;
+}
+
+
+
+
+// UPDATE-PAGERANK-COMPRESSION
+// ---------------------------
+// Target of an updated edge leaves its identical group (only its in-edges
+// change), and chains touching either end are dissolved. These vertices are
+// then checked again (along with possible identical partners).
+
+template <class G, class H>
+void updatePagerankCompressionDissolve(vector<int>& ks, PagerankCompression& a, const G& y, const H& yt, int u, int v) {
+  auto fc = [&](int c) {
+    for (int w : a.chains[c]) { a.chainIds[w] = -1; ks.push_back(w); }
+    a.chains[c] = vector<int>();
+  };
+  auto fd = [&](int u) {
+    if (a.chainIds[u]>=0) fc(a.chainIds[u]);
+    for (int w : y.edges(u))   // u may be a chain head
+      if (a.chainIds[w]>=0) fc(a.chainIds[w]);
+    for (int w : yt.edges(u))  // or a chain tail
+      if (a.chainIds[w]>=0) fc(a.chainIds[w]);
+  };
+  int g = a.identicalIds[v];
+  if (g>=0) {
+    auto& is = a.identicals[g];
+    is.erase(find(is.begin(), is.end(), v));
+    a.identicalIds[v] = -1;
+    if (is.size()==1) { a.identicalIds[is[0]] = -1; is.clear(); }
+  }
+  ks.push_back(u); fd(u);
+  ks.push_back(v); fd(v);
+}
+
+
+template <class G, class H>
+void updatePagerankCompressionIdenticals(PagerankCompression& a, const G& y, const H& yt, const vector<int>& ks) {
+  vector<int> ps;
+  vector<bool> vis(y.span());
+  // Identical partners of a vertex are out-neighbours of any in-neighbour.
+  for (int u : ks) {
+    if (!y.hasVertex(u) || a.chainIds[u]>=0 || yt.degree(u)==0) continue;
+    int s = -1;
+    for (int v : yt.edges(u))
+      if (s<0 || y.degree(v) < y.degree(s)) s = v;
+    for (int v : y.edges(s))
+      if (a.chainIds[v]<0) ps.push_back(v);
+    vis[u] = true;
+  }
+  sort(ps.begin(), ps.end());
+  ps.erase(unique(ps.begin(), ps.end()), ps.end());
+  // Replace old groups with new ones (if any updated vertex is present).
+  for (auto& g : edgeIdenticalsFromSize(yt, ps, 2)) {
+    if (none_of(g.begin(), g.end(), [&](int v) { return bool(vis[v]); })) continue;
+    for (int v : g) {
+      int o = a.identicalIds[v];
+      if (o<0) continue;
+      for (int w : a.identicals[o])
+        a.identicalIds[w] = -1;
+      a.identicals[o] = vector<int>();
+    }
+    int c = a.identicals.size();
+    for (int v : g)
+      a.identicalIds[v] = c;
+    a.identicals.push_back(move(g));
+  }
+}
+
+
+// Update compression with a batch of edge updates.
+// @param a  compression of old graph (updated)
+// @param y  updated graph
+// @param yt transpose of updated graph
+template <class G, class H>
+void updatePagerankCompression(PagerankCompression& a, const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions) {
+  vector<int> ks;
+  if (int(a.identicalIds.size()) < y.span()) a.identicalIds.resize(y.span(), -1);
+  if (int(a.chainIds.size())     < y.span()) a.chainIds.resize(y.span(), -1);
+  for (const auto& [u, v] : deletions)
+    updatePagerankCompressionDissolve(ks, a, y, yt, u, v);
+  for (const auto& [u, v] : insertions)
+    updatePagerankCompressionDissolve(ks, a, y, yt, u, v);
+  sort(ks.begin(), ks.end());
+  ks.erase(unique(ks.begin(), ks.end()), ks.end());
+  auto ls = filterIter(ks, [&](int u) { return y.hasVertex(u) && a.chainIds[u]<0; });
+  pagerankCompressChains(a, y, yt, ls);
+  updatePagerankCompressionIdenticals(a, y, yt, ks);
+  pagerankCompressCount(a, yt);
+}
+
+
+
+
+// PAGERANK-EXPAND
+// ---------------
+// Rank of a compressed vertex (v) is linear in rank of its source (u).
+
+template <class T>
+struct PagerankExpand {
+  int v, u;
+  T   a, b;  // rank(v) = a + b * rank(u)
+};
+
+
+template <class T>
+void pagerankExpandOmp(vector<T>& a, vector<T>& cn, const vector<T>& f, const vector<PagerankExpand<T>>& es) {
+  int E = es.size();
+  #pragma omp parallel for schedule(static, 2048)
+  for (int i=0; i<E; i++) {
+    const auto& e = es[i];
+    a[e.v]  = e.a + e.b * a[e.u];
+    cn[e.v] = a[e.v] * f[e.v];
+  }
+}
+
+
+template <class T>
+void pagerankExpandCopyOmp(vector<T>& r, vector<T>& cn, const vector<T>& a, const vector<T>& c, const vector<PagerankExpand<T>>& es) {
+  int E = es.size();
+  #pragma omp parallel for schedule(static, 2048)
+  for (int i=0; i<E; i++) {
+    int v = es[i].v;
+    r[v]  = a[v];
+    cn[v] = c[v];
+  }
+}
+
+
+// Compressed vertices of each group (by group of source).
+// Only last interior vertex of a chain is needed on every iteration (es),
+// others are needed only after convergence (fs).
+template <class V, class T>
+void pagerankExpansions(vector2d<PagerankExpand<T>>& es, vector2d<PagerankExpand<T>>& fs, vector<uint8_t>& vskp, const CsrDiGraph<V>& xt, const PagerankCompression& C, const vector<int>& gv, int N, T p) {
+  int S = xt.span();
+  T  c0 = (1-p)/N;
+  auto ff = [&](int u) { int d = xt.vertexData(u); return d>0? p/d : T(); };
+  vector<int> vrep(S, -1);
+  // Representative has least group (iterated before others).
+  for (const auto& g : C.identicals) {
+    if (g.empty()) continue;
+    int r = g[0];
+    for (int u : g)
+      if (gv[u] < gv[r]) r = u;
+    if (gv[r]==INT_MAX) continue;
+    for (int u : g) {
+      if (u==r) continue;
+      PagerankExpand<T> e {u, r, T(), T(1)};
+      es[gv[r]].push_back(e);
+      fs[gv[r]].push_back(e);
+      vrep[u] = r; vskp[u] = 1;
+    }
+  }
+  // Chain interiors from rank of head: r(v1) = c0 + f(h) r(h), ...
+  for (const auto& c : C.chains) {
+    if (c.empty()) continue;
+    int h = edge(xt, c[0]), r = vrep[h]>=0? vrep[h] : h;
+    if (gv[r]==INT_MAX) continue;
+    T ca = c0, cb = ff(h);
+    for (size_t i=0; i<c.size(); ++i) {
+      PagerankExpand<T> e {c[i], r, ca, cb};
+      if (i+1==c.size()) es[gv[r]].push_back(e);
+      fs[gv[r]].push_back(e);
+      vskp[c[i]] = 1;
+      T fi = ff(c[i]);
+      ca = c0 + fi*ca; cb = fi*cb;
+    }
+  }
+}
+
+
+
+
+// PAGERANK-LOOP
+// -------------
+
+template <class T, class J, class C>
+float pagerankCompressedOmpLoop(vector<T>& a, vector<T>& r, vector<T>& c, vector<T>& cn, const vector<T>& f, const C& xc, int i, const J& ns, int N, T p, T E, int L, int EF, const vector2d<PagerankExpand<T>>& es, const vector2d<PagerankExpand<T>>& fs) {
+  T  c0 = (1-p)/N;
+  float t = 0; int g = 0;
+  for (int n : ns) {
+    if (n<=0) { g++; continue; }
+    T En = EF<=2? E*n/N : E;
+    auto ps = pagerankPartitionOmp(xc, i, n);
+    int l = 0;
+    while (l<L) {
+      T el = T();
+      t += pagerankUpdateOmp(el, a, cn, r, c, f, xc, ps, c0, EF); ++l;  // calculate ranks, error, contributions (one iteration complete)
+      if (!es[g].empty()) t += measureDuration([&]() { pagerankExpandOmp(a, cn, f, es[g]); });  // contributions of compressed vertices
+      swap(c, cn);                                                       // new contributions (c)
+      if (el<En || l>=L) break;                                          // check tolerance, iteration limit
+      swap(a, r);                                                        // final ranks always in (a)
+    }
+    // Final ranks of compressed vertices (in both a, r).
+    if (!fs[g].empty()) {
+      t += measureDuration([&]() { pagerankExpandOmp(a, c, f, fs[g]); });
+      pagerankExpandCopyOmp(r, cn, a, c, fs[g]);
+    }
+    pagerankContributionCopyOmp(cn, c, xc, i, n);
+    swap(a, r);
+    i += n; g++;
+  }
+  swap(a, r);
+  return t;
+}
+
+
+
+
+// PAGERANK (COMPRESSED)
+// ---------------------
+// Find pagerank, leaving out compressed vertices from iteration.
+// Vertices in groups (ns) of order ks are iterated, others keep old ranks.
+
+template <class V, class J, class T=float>
+PagerankResult<T> pagerankCompressedOmp(const CsrDiGraph<V>& xt, const vector<int>& ks, const J& ns, const PagerankCompression& C, const vector<T> *q, const PagerankOptions<T>& o) {
+  int S = xt.span(), N = xt.order();
+  int G = 0, i = 0;
+  vector<int> gv(S, INT_MAX);
+  for (int n : ns) {
+    for (int j=i; j<i+n; j++)
+      gv[ks[j]] = G;
+    i += n; G++;
+  }
+  vector2d<PagerankExpand<T>> es(G), fs(G);
+  vector<uint8_t> vskp(S);
+  pagerankExpansions(es, fs, vskp, xt, C, gv, N, o.damping);
+  // Compressed vertices are moved after iterated ones.
+  vector<int> ls, ms; i = 0;
+  for (int n : ns) {
+    int m = 0;
+    for (int j=i; j<i+n; j++)
+      if (!vskp[ks[j]]) { ls.push_back(ks[j]); m++; }
+    ms.push_back(m);
+    i += n;
+  }
+  for (int j=0; j<int(ks.size()); j++)
+    if (j>=i || vskp[ks[j]]) ls.push_back(ks[j]);
+  auto fl = [&](auto& a, auto& r, auto& c, auto& cn, const auto& f, const auto& xc, int i, const auto& ns, int N, T p, T E, int L, int EF) {
+    return pagerankCompressedOmpLoop(a, r, c, cn, f, xc, i, ns, N, p, E, L, EF, es, fs);
+  };
+  return pagerankOmp(xt, ls, 0, ms, fl, q, o);
+}
@@ -34,9 +34,10 @@ using std::swap;
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankLevelwiseCuda(const G& x, const H& xt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
   int  N  = xt.order();  if (N==0) return PagerankResult<T>::initial(xt, q);
-  const auto& cs = componentsD(x, xt, D);
-  const auto& b  = blockgraphD(x, cs, D);
-  const auto& bt = blockgraphTransposeD(b, D);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, x, xt, D);
+  const auto& b  = blockgraphD(Dx, x, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
   auto gs = levelwiseGroupedComponentsFrom(cs, bt);
   forEach(gs, [&](auto& g) { pagerankPartition(xt, g); });
   auto ns = pagerankPairWave(xt, gs);
@@ -59,9 +60,10 @@ PagerankResult<T> pagerankLevelwiseCuda(const G& x, const vector<T> *q=nullptr,
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankLevelwiseCudaDynamic(const G& x, const H& xt, const G& y, const H& yt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
   int  N  = yt.order();                                 if (N==0) return PagerankResult<T>::initial(yt, q);
-  const auto& cs = componentsD(y, yt, D);
-  const auto& b  = blockgraphD(y, cs, D);
-  const auto& bt = blockgraphTransposeD(b, D);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, y, yt, D);
+  const auto& b  = blockgraphD(Dx, y, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
   auto gi = levelwiseGroupIndices(bt);
   auto [is, n] = dynamicComponentIndices(x, y, cs, b);  if (n==0) return PagerankResult<T>::initial(yt, q);
   auto ig = groupBy<int>(sliceIter(is, 0, n), [&](int i) { return gi[i]; });
@@ -13,7 +13,9 @@
 #include "pagerankOmp.hxx"
 #include "pagerankMonolithicOmp.hxx"
 #include "pagerankComponentwiseOmp.hxx"
+#include "pagerankCompress.hxx"
 
+using std::pair;
 using std::vector;
 using std::swap;
 
@@ -32,13 +34,14 @@ using std::swap;
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankLevelwiseOmp(const G& x, const H& xt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
   int  N  = xt.order();  if (N==0) return PagerankResult<T>::initial(xt, q);
-  const auto& cs = componentsD(x, xt, D);
-  const auto& b  = blockgraphD(x, cs, D);
-  const auto& bt = blockgraphTransposeD(b, D);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, x, xt, D);
+  const auto& b  = blockgraphD(Dx, x, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
   auto gs = levelwiseGroupedComponentsFrom(cs, bt);
   auto ns = transformIter(gs, [&](const auto& g) { return g.size(); });
   auto ks = join<int>(gs);
-  return pagerankOmp(xt, ks, 0, ns, pagerankComponentwiseOmpLoop<T, decltype(ns)>, q, o);
+  return pagerankOmp(xt, ks, 0, ns, pagerankComponentwiseOmpLoopFn<T>(), q, o);
 }
 template <class G, class T=float>
 PagerankResult<T> pagerankLevelwiseOmp(const G& x, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
@@ -55,16 +58,17 @@ PagerankResult<T> pagerankLevelwiseOmp(const G& x, const vector<T> *q=nullptr, c
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankLevelwiseOmpDynamic(const G& x, const H& xt, const G& y, const H& yt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
   int  N  = yt.order();                                 if (N==0) return PagerankResult<T>::initial(yt, q);
-  const auto& cs = componentsD(y, yt, D);
-  const auto& b  = blockgraphD(y, cs, D);
-  const auto& bt = blockgraphTransposeD(b, D);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, y, yt, D);
+  const auto& b  = blockgraphD(Dx, y, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
   auto gi = levelwiseGroupIndices(bt);
   auto [is, n] = dynamicComponentIndices(x, y, cs, b);  if (n==0) return PagerankResult<T>::initial(yt, q);
   auto ig = groupBy<int>(sliceIter(is, 0, n), [&](int i) { return gi[i]; });
   auto gs = joinAt2d<int>(cs, ig);
   auto ns = transformIter(gs, [&](const auto& g) { return g.size(); });
   auto ks = join<int>(gs); joinAt(ks, cs, sliceIter(is, n));
-  return pagerankOmp(yt, ks, 0, ns, pagerankComponentwiseOmpLoop<T, decltype(ns)>, q, o);
+  return pagerankOmp(yt, ks, 0, ns, pagerankComponentwiseOmpLoopFn<T>(), q, o);
 }
 
 template <class G, class T=float>
@@ -73,3 +77,97 @@ PagerankResult<T> pagerankLevelwiseOmpDynamic(const G& x, const G& y, const vect
   auto yt = transposeWithDegree(y);
   return pagerankLevelwiseOmpDynamic(x, xt, y, yt, q, o, D);
 }
+
+
+// Find affected components from a batch of edge updates, instead of comparing graphs.
+// @param y  updated graph
+// @param yt transpose of updated graph (with vertex-data=out-degree)
+// @param deletions edges removed from old graph
+// @param insertions edges added to old graph
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankLevelwiseOmpDynamic(const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  int  N  = yt.order();  if (N==0) return PagerankResult<T>::initial(yt, q);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, y, yt, D);
+  const auto& ci = componentIdsD(Dx, y, cs, D);
+  const auto& b  = blockgraphD(Dx, y, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
+  const auto& gi = levelwiseGroupIndicesD(Dx, bt, D);
+  auto [is, n] = dynamicComponentIndicesFrom(cs, ci, b, deletions, insertions);  if (n==0) return PagerankResult<T>::initial(yt, q);
+  auto ig = groupBy<int>(sliceIter(is, 0, n), [&](int i) { return gi[i]; });
+  auto gs = joinAt2d<int>(cs, ig);
+  auto ns = transformIter(gs, [&](const auto& g) { return g.size(); });
+  auto ks = join<int>(gs); joinAt(ks, cs, sliceIter(is, n));
+  return pagerankOmp(yt, ks, 0, ns, pagerankComponentwiseOmpLoopFn<T>(), q, o);
+}
+
+
+
+
+// PAGERANK (DYNAMIC FRONTIER)
+// ---------------------------
+
+// Find pagerank levelwise, updating only vertices reached by a significant rank change.
+// @param y  updated graph
+// @param yt transpose of updated graph (with vertex-data=out-degree)
+// @param deletions edges removed from old graph
+// @param insertions edges added to old graph
+// @param q  ranks of old graph (adjusted to updated graph)
+// @param o  options {..., frontierTolerance=1e-6}
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankLevelwiseOmpFrontier(const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  int  N  = yt.order();  if (N==0) return PagerankResult<T>::initial(yt, q);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, y, yt, D);
+  const auto& b  = blockgraphD(Dx, y, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
+  const auto& gi = levelwiseGroupIndicesD(Dx, bt, D);
+  auto ig = groupBy<int>(bt.vertices(), [&](int i) { return gi[i]; });
+  auto gs = joinAt2d<int>(cs, ig);
+  auto ns = transformIter(gs, [&](const auto& g) { return int(g.size()); });
+  auto ks = join<int>(gs);
+  return pagerankFrontierOmp(y, yt, ks, ns, deletions, insertions, q, o);
+}
+
+
+
+
+// PAGERANK (COMPRESSED)
+// ---------------------
+// In-identical vertices, and chain interiors are not iterated upon (CsrDiGraph only).
+// A representative in the earliest level is chosen for in-identical vertices.
+
+// Find pagerank levelwise, with compressed vertices left out of iteration.
+// @param C  compression of original graph
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankLevelwiseOmpCompressed(const G& x, const H& xt, const vector<T> *q, const PagerankOptions<T>& o, const PagerankCompression& C, const PagerankData<G> *D=nullptr) {
+  int  N  = xt.order();  if (N==0) return PagerankResult<T>::initial(xt, q);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, x, xt, D);
+  const auto& b  = blockgraphD(Dx, x, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
+  auto gs = levelwiseGroupedComponentsFrom(cs, bt);
+  auto ns = transformIter(gs, [&](const auto& g) { return int(g.size()); });
+  auto ks = join<int>(gs);
+  return pagerankCompressedOmp(xt, ks, ns, C, q, o);
+}
+
+
+// Find pagerank levelwise, with compressed vertices left out of iteration, from a batch of edge updates.
+// @param C  compression of updated graph
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankLevelwiseOmpCompressedDynamic(const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const vector<T> *q, const PagerankOptions<T>& o, const PagerankCompression& C, const PagerankData<G> *D=nullptr) {
+  int  N  = yt.order();  if (N==0) return PagerankResult<T>::initial(yt, q);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, y, yt, D);
+  const auto& ci = componentIdsD(Dx, y, cs, D);
+  const auto& b  = blockgraphD(Dx, y, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
+  const auto& gi = levelwiseGroupIndicesD(Dx, bt, D);
+  auto [is, n] = dynamicComponentIndicesFrom(cs, ci, b, deletions, insertions);  if (n==0) return PagerankResult<T>::initial(yt, q);
+  auto ig = groupBy<int>(sliceIter(is, 0, n), [&](int i) { return gi[i]; });
+  auto gs = joinAt2d<int>(cs, ig);
+  auto ns = transformIter(gs, [&](const auto& g) { return int(g.size()); });
+  auto ks = join<int>(gs); joinAt(ks, cs, sliceIter(is, n));
+  return pagerankCompressedOmp(yt, ks, ns, C, q, o);
+}
@@ -34,9 +34,10 @@ using std::move;
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankLevelwiseSeq(const G& x, const H& xt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
   int  N  = xt.order();  if (N==0) return PagerankResult<T>::initial(xt, q);
-  const auto& cs = componentsD(x, xt, D);
-  const auto& b  = blockgraphD(x, cs, D);
-  const auto& bt = blockgraphTransposeD(b, D);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, x, xt, D);
+  const auto& b  = blockgraphD(Dx, x, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
   auto gs = levelwiseGroupedComponentsFrom(cs, bt);
   auto ns = transformIter(gs, [&](const auto& g) { return g.size(); });
   auto ks = join<int>(gs);
@@ -57,9 +58,10 @@ PagerankResult<T> pagerankLevelwiseSeq(const G& x, const vector<T> *q=nullptr, c
 template <class G, class H, class T=float>
 PagerankResult<T> pagerankLevelwiseSeqDynamic(const G& x, const H& xt, const G& y, const H& yt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
   int  N  = yt.order();  if (N==0) return PagerankResult<T>::initial(yt, q);
-  const auto& cs = componentsD(x, xt, D);
-  const auto& b  = blockgraphD(x, cs, D);
-  const auto& bt = blockgraphTransposeD(b, D);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, x, xt, D);
+  const auto& b  = blockgraphD(Dx, x, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
   auto gi = levelwiseGroupIndices(bt);
   auto [is, n] = dynamicComponentIndices(x, y, cs, b);  if (n==0) return PagerankResult<T>::initial(yt, q);
   auto ig = groupBy<int>(sliceIter(is, 0, n), [&](int i) { return gi[i]; });
@@ -6,7 +6,9 @@
 #include "dynamic.hxx"
 #include "pagerank.hxx"
 #include "pagerankOmp.hxx"
+#include "pagerankCompress.hxx"
 
+using std::pair;
 using std::vector;
 using std::swap;
 
@@ -16,21 +18,29 @@ using std::swap;
 // PAGERANK-LOOP
 // -------------
 
-template <class T>
-float pagerankMonolithicOmpLoop(vector<T>& a, vector<T>& r, vector<T>& c, const vector<T>& f, const vector<int>& vfrom, const vector<int>& efrom, int i, int n, int N, T p, T E, int L, int EF) {
+template <class T, class C>
+float pagerankMonolithicOmpLoop(vector<T>& a, vector<T>& r, vector<T>& c, vector<T>& cn, const vector<T>& f, const C& xc, int i, int n, int N, T p, T E, int L, int EF) {
   T  c0 = (1-p)/N;
   int l = 0;
   float t = 0;
+  auto ps = pagerankPartitionOmp(xc, i, n);  // edge-balanced ranges for threads
   while (l<L) {
-    t += pagerankCalculateOmp(a, c, vfrom, efrom, i, n, c0);  // assume contribtions (c) is precalculated
-    T el = pagerankErrorOmp(a, r, i, n, EF); ++l;             // one iteration complete
-    if (el<E || l>=L) break;                                  // check tolerance, iteration limit
-    multiplyOmp(c, a, f, i, n);                               // update partial contributions (c)
-    swap(a, r);                                               // final ranks always in (a)
+    T el = T();
+    t += pagerankUpdateOmp(el, a, cn, r, c, f, xc, ps, c0, EF); ++l;  // calculate ranks, error, contributions (one iteration complete)
+    swap(c, cn);                                                       // new contributions (c)
+    if (el<E || l>=L) break;                                           // check tolerance, iteration limit
+    swap(a, r);                                                        // final ranks always in (a)
   }
+  pagerankContributionCopyOmp(cn, c, xc, i, n);  // keep both contribution buffers in sync
   return t;
 }
 
+// Loop for in-edges in any format (see EdgeFormat).
+template <class T>
+auto pagerankMonolithicOmpLoopFn() {
+  return [](auto&... args) { return pagerankMonolithicOmpLoop<T>(args...); };
+}
+
 
 
 
@@ -47,7 +57,7 @@ template <class G, class H, class T=float>
 PagerankResult<T> pagerankMonolithicOmp(const G& x, const H& xt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
   int  N  = xt.order();  if (N==0) return PagerankResult<T>::initial(xt, q);
   auto ks = pagerankVertices(x, xt, o, D);
-  return pagerankOmp(xt, ks, 0, N, pagerankMonolithicOmpLoop<T>, q, o);
+  return pagerankOmp(xt, ks, 0, N, pagerankMonolithicOmpLoopFn<T>(), q, o);
 }
 
 template <class G, class T=float>
@@ -66,7 +76,7 @@ template <class G, class H, class T=float>
 PagerankResult<T> pagerankMonolithicOmpDynamic(const G& x, const H& xt, const G& y, const H& yt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
   int  N = yt.order();                                         if (N==0) return PagerankResult<T>::initial(yt, q);
   auto [ks, n] = pagerankDynamicVertices(x, xt, y, yt, o, D);  if (n==0) return PagerankResult<T>::initial(yt, q);
-  return pagerankOmp(yt, ks, 0, n, pagerankMonolithicOmpLoop<T>, q, o);
+  return pagerankOmp(yt, ks, 0, n, pagerankMonolithicOmpLoopFn<T>(), q, o);
 }
 
 template <class G, class T=float>
@@ -75,3 +85,69 @@ PagerankResult<T> pagerankMonolithicOmpDynamic(const G& x, const G& y, const vec
   auto yt = transposeWithDegree(y);
   return pagerankMonolithicOmpDynamic(x, xt, y, yt, q, o, D);
 }
+
+
+// Find affected vertices from a batch of edge updates, instead of comparing graphs.
+// @param y  updated graph
+// @param yt transpose of updated graph (with vertex-data=out-degree)
+// @param deletions edges removed from old graph
+// @param insertions edges added to old graph
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankMonolithicOmpDynamic(const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  int  N = yt.order();                                                         if (N==0) return PagerankResult<T>::initial(yt, q);
+  auto [ks, n] = pagerankDynamicVertices(y, yt, deletions, insertions, o, D);  if (n==0) return PagerankResult<T>::initial(yt, q);
+  return pagerankOmp(yt, ks, 0, n, pagerankMonolithicOmpLoopFn<T>(), q, o);
+}
+
+
+
+
+// PAGERANK (DYNAMIC FRONTIER)
+// ---------------------------
+
+// Find pagerank, updating only vertices reached by a significant rank change.
+// @param y  updated graph
+// @param yt transpose of updated graph (with vertex-data=out-degree)
+// @param deletions edges removed from old graph
+// @param insertions edges added to old graph
+// @param q  ranks of old graph (adjusted to updated graph)
+// @param o  options {..., frontierTolerance=1e-6}
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankMonolithicOmpFrontier(const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  int  N  = yt.order();  if (N==0) return PagerankResult<T>::initial(yt, q);
+  auto ks = pagerankVertices(y, yt, o, D);
+  vector<int> ns {int(ks.size())};
+  return pagerankFrontierOmp(y, yt, ks, ns, deletions, insertions, q, o);
+}
+
+
+
+
+// PAGERANK (COMPRESSED)
+// ---------------------
+// In-identical vertices, and chain interiors are not iterated upon (CsrDiGraph only).
+
+// Find pagerank with compressed vertices left out of iteration.
+// @param x  original graph
+// @param xt transpose graph (with vertex-data=out-degree)
+// @param q  initial ranks (optional)
+// @param o  options {damping=0.85, tolerance=1e-6, maxIterations=500}
+// @param C  compression of original graph
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankMonolithicOmpCompressed(const G& x, const H& xt, const vector<T> *q, const PagerankOptions<T>& o, const PagerankCompression& C, const PagerankData<G> *D=nullptr) {
+  int  N  = xt.order();  if (N==0) return PagerankResult<T>::initial(xt, q);
+  auto ks = pagerankVertices(x, xt, o, D);
+  vector<int> ns {int(ks.size())};
+  return pagerankCompressedOmp(xt, ks, ns, C, q, o);
+}
+
+
+// Find pagerank with compressed vertices left out of iteration, from a batch of edge updates.
+// @param C  compression of updated graph
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankMonolithicOmpCompressedDynamic(const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const vector<T> *q, const PagerankOptions<T>& o, const PagerankCompression& C, const PagerankData<G> *D=nullptr) {
+  int  N = yt.order();                                                         if (N==0) return PagerankResult<T>::initial(yt, q);
+  auto [ks, n] = pagerankDynamicVertices(y, yt, deletions, insertions, o, D);  if (n==0) return PagerankResult<T>::initial(yt, q);
+  vector<int> ns {int(n)};
+  return pagerankCompressedOmp(yt, ks, ns, C, q, o);
+}
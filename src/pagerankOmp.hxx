@@ -1,15 +1,127 @@
 #pragma once
+#include <utility>
 #include <vector>
+#include <cstdint>
+#include <climits>
+#include <cmath>
 #include <algorithm>
 #include "_main.hxx"
 #include "vertices.hxx"
 #include "edges.hxx"
 #include "csr.hxx"
+#include "CsrDiGraph.hxx"
 #include "pagerank.hxx"
 #include "pagerankSeq.hxx"
 
+using std::pair;
+using std::make_pair;
 using std::vector;
 using std::swap;
+using std::min;
+using std::max;
+using std::abs;
+using std::sqrt;
+using std::sort;
+using std::is_sorted;
+
+
+
+
+// PAGERANK-CSR
+// ------------
+// In-edges of vertices in given order (ks), as used by the kernels.
+// Generic graphs are flattened into a copy, indexed by position in ks, with
+// 64-bit offsets (O) only when there are too many edges for 32-bit ones.
+// CsrDiGraph is used in-place (no copy, 64-bit block offsets), indexed by vertex.
+// Packed in-edges are sorted, delta + varint coded, and decoded by the kernel.
+
+enum EdgeFormat {
+  EDGES_AUTO = 0,  // CSR copy with 32 (or 64-bit) offsets, CsrDiGraph in-place
+  EDGES_OFFSET64,  // CSR copy with 64-bit offsets (any graph)
+  EDGES_PACKED     // packed copy (about 1-2 bytes per edge)
+};
+
+
+template <class O=int>
+struct PagerankCsrCopy {
+  vector<O>   vfrom;
+  vector<int> efrom;
+  const int  *ks = nullptr;  // vertex at each position (if indexed by vertex)
+};
+
+template <class V>
+struct PagerankCsrView {
+  const CsrDiGraph<V>& xt;
+  const vector<int>& ks;
+};
+
+template <class O=int64_t>
+struct PagerankCsrPacked {
+  vector<O> vfrom;          // start of in-edges of each position (bytes)
+  vector<uint8_t> efrom;    // in-edges (delta + varint)
+  const int *ks = nullptr;  // vertex at each position (if indexed by vertex)
+};
+
+
+template <class O, class H, class J>
+void pagerankCsrFrom(PagerankCsrCopy<O>& a, const H& xt, const J& ks) {
+  a.vfrom = sourceOffsets<O>(xt, ks);
+  a.efrom = destinationIndices(xt, ks);
+}
+
+// Sources of in-edges are kept as vertices (indexed by vertex).
+template <class O, class H>
+void pagerankCsrCopyOmp(PagerankCsrCopy<O>& a, const H& xt, const vector<int>& ks) {
+  int K = ks.size();
+  a.vfrom = sourceOffsets<O>(xt, ks);
+  a.efrom.resize(a.vfrom[K]);
+  #pragma omp parallel for schedule(dynamic, 2048)
+  for (int j=0; j<K; j++) {
+    O i = a.vfrom[j];
+    for (int u : xt.edges(ks[j]))
+      a.efrom[i++] = u;
+  }
+  a.ks = ks.data();
+}
+
+// Sources of in-edges are mapped by fm (to position, or vertex).
+template <class O, class H, class J, class FM>
+void pagerankCsrPackOmp(PagerankCsrPacked<O>& a, const H& xt, const J& ks, FM fm) {
+  int K = ks.size();
+  auto fs = [&](vector<int>& es, int u) {
+    es.clear();
+    for (int v : xt.edges(u))
+      es.push_back(fm(v));
+    if (!is_sorted(es.begin(), es.end())) sort(es.begin(), es.end());
+  };
+  a.vfrom.assign(K+1, O());
+  #pragma omp parallel
+  {
+    vector<int> es;
+    #pragma omp for schedule(dynamic, 2048)
+    for (int j=0; j<K; j++) {
+      fs(es, ks[j]);
+      a.vfrom[j] = O(deltaVarintSize(es.data(), es.size()));
+    }
+  }
+  O B = exclusiveScan(a.vfrom);
+  a.efrom.resize(B);
+  #pragma omp parallel
+  {
+    vector<int> es;
+    #pragma omp for schedule(dynamic, 2048)
+    for (int j=0; j<K; j++) {
+      fs(es, ks[j]);
+      writeDeltaVarint(a.efrom.data() + a.vfrom[j], es.data(), es.size());
+    }
+  }
+}
+
+template <class O, class H, class J>
+void pagerankCsrFrom(PagerankCsrPacked<O>& a, const H& xt, const J& ks) {
+  auto ids = indices(ks);
+  pagerankCsrPackOmp(a, xt, ks, [&](int v) { return ids[v]; });
+}
 
 
 
@@ -20,7 +132,7 @@ using std::swap;
 
 template <class T>
 void pagerankFactorOmp(vector<T>& a, const vector<int>& vdata, int i, int n, T p) {
-  #pragma omp parallel for num_threads(32) schedule(auto)
+  #pragma omp parallel for schedule(auto)
   for (int u=i; u<i+n; u++) {
     int d = vdata[u];
     a[u] = d>0? p/d : 0;
@@ -30,33 +142,150 @@ void pagerankFactorOmp(vector<T>& a, const vector<int>& vdata, int i, int n, T p
 
 
 
-// PAGERANK-CALCULATE
+// PAGERANK-PARTITION
 // ------------------
-// For rank calculation from in-edges.
+// Split vertices in range [i, i+n) among threads, with about equal work
+// (vertices + in-edges) each. Work upto position j is given by fw(j).
 
-template <class T>
-float pagerankCalculateOmp(vector<T>& a, const vector<T>& c, const vector<int>& vfrom, const vector<int>& efrom, int i, int n, T c0) {
-  return measureDuration([&]() {
-    #pragma omp parallel for num_threads(32) schedule(auto)
-    for (int v=i; v<i+n; v++)
-      a[v] = c0 + sumAt(c, sliceIter(efrom, vfrom[v], vfrom[v+1]));
+template <class FW>
+auto pagerankPartitionBy(int i, int n, int P, FW fw) {
+  vector<int> a(P+1);
+  int64_t W0 = fw(i), W = fw(i+n) - W0;
+  a[0] = i; a[P] = i+n;
+  for (int t=1; t<P; t++) {
+    int64_t w = W0 + W*t/P;
+    int lo = a[t-1], hi = i+n;  // find first position with work >= w
+    while (lo<hi) {
+      int m = lo + (hi-lo)/2;
+      if (fw(m)<w) lo = m+1;
+      else hi = m;
+    }
+    a[t] = lo;
+  }
+  return a;
+}
+
+template <class O>
+auto pagerankPartitionOmp(const PagerankCsrCopy<O>& xc, int i, int n) {
+  const O *vfrom = xc.vfrom.data();
+  return pagerankPartitionBy(i, n, omp_get_max_threads(), [&](int j) { return int64_t(j) + vfrom[j]; });
+}
+
+// Bytes of packed in-edges stand in for their count.
+template <class O>
+auto pagerankPartitionOmp(const PagerankCsrPacked<O>& xc, int i, int n) {
+  const O *vfrom = xc.vfrom.data();
+  return pagerankPartitionBy(i, n, omp_get_max_threads(), [&](int j) { return int64_t(j) + vfrom[j]; });
+}
+
+template <class V>
+auto pagerankPartitionOmp(const PagerankCsrView<V>& xc, int i, int n) {
+  const int *ks   = xc.ks.data();
+  const int *edeg = xc.xt.degrees().data();
+  vector<int64_t> ws(n+1);
+  for (int j=0; j<n; j++)
+    ws[j+1] = ws[j] + 1 + edeg[ks[i+j]];
+  return pagerankPartitionBy(i, n, omp_get_max_threads(), [&](int j) { return ws[j-i]; });
+}
+
+
+
+
+// PAGERANK-UPDATE
+// ---------------
+// For rank calculation from in-edges, in a single pass (per partition).
+// Finds new ranks (a), error (e), and new contributions (cn) together.
+// Vertex, and sum of in-edge contributions at each position is given by fv(j).
+
+template <class T, class FV>
+float pagerankUpdateOmpBy(T& e, vector<T>& a, vector<T>& cn, const vector<T>& r, const vector<T>& f, const vector<int>& ps, T c0, int EF, FV fv) {
+  int P = ps.size() - 1;
+  T e1 = T(), e2 = T(), ei = T();
+  float t = measureDuration([&]() {
+    #pragma omp parallel num_threads(P) reduction(+:e1,e2) reduction(max:ei)
+    for (int p=omp_get_thread_num(); p<P; p+=omp_get_num_threads()) {
+      for (int j=ps[p]; j<ps[p+1]; j++) {
+        auto [v, s] = fv(j);
+        T av = c0 + s;
+        T dv = abs(av - r[v]);
+        e1 += dv; e2 += dv*dv; ei = max(ei, dv);
+        a[v]  = av;
+        cn[v] = av * f[v];
+      }
+    }
   });
+  e = EF==1? e1 : (EF==2? sqrt(e2) : ei);
+  return t;
 }
 
+template <class T, class O>
+float pagerankUpdateOmp(T& e, vector<T>& a, vector<T>& cn, const vector<T>& r, const vector<T>& c, const vector<T>& f, const PagerankCsrCopy<O>& xc, const vector<int>& ps, T c0, int EF) {
+  const int *ks    = xc.ks;
+  const T   *cs    = c.data();
+  const O   *vfrom = xc.vfrom.data();
+  const int *efrom = xc.efrom.data();
+  return pagerankUpdateOmpBy(e, a, cn, r, f, ps, c0, EF, [&](int j) {
+    int v = ks? ks[j] : j;
+    return make_pair(v, gatherSum(cs, efrom+vfrom[j], int(vfrom[j+1]-vfrom[j])));
+  });
+}
 
+template <class T, class V>
+float pagerankUpdateOmp(T& e, vector<T>& a, vector<T>& cn, const vector<T>& r, const vector<T>& c, const vector<T>& f, const PagerankCsrView<V>& xc, const vector<int>& ps, T c0, int EF) {
+  const int *ks   = xc.ks.data();
+  const size_t *eoff = xc.xt.offsets().data();
+  const int *edeg = xc.xt.degrees().data();
+  const int *ekey = xc.xt.edgeKeys().data();
+  const T   *cs   = c.data();
+  return pagerankUpdateOmpBy(e, a, cn, r, f, ps, c0, EF, [&](int j) {
+    int v = ks[j];
+    return make_pair(v, gatherSum(cs, ekey+eoff[v], edeg[v]));
+  });
+}
 
+template <class T, class O>
+float pagerankUpdateOmp(T& e, vector<T>& a, vector<T>& cn, const vector<T>& r, const vector<T>& c, const vector<T>& f, const PagerankCsrPacked<O>& xc, const vector<int>& ps, T c0, int EF) {
+  const int *ks    = xc.ks;
+  const T   *cs    = c.data();
+  const O   *vfrom = xc.vfrom.data();
+  const uint8_t *efrom = xc.efrom.data();
+  return pagerankUpdateOmpBy(e, a, cn, r, f, ps, c0, EF, [&](int j) {
+    int v = ks? ks[j] : j;
+    return make_pair(v, gatherSumDeltaVarint(cs, efrom+vfrom[j], efrom+vfrom[j+1]));
+  });
+}
 
-// PAGERANK-ERROR
-// --------------
-// For convergence check.
 
-template <class T>
-T pagerankErrorOmp(const vector<T>& x, const vector<T>& y, int i, int N, int EF) {
-  switch (EF) {
-    case 1:  return l1NormOmp(x, y, i, N);
-    case 2:  return l2NormOmp(x, y, i, N);
-    default: return liNormOmp(x, y, i, N);
-  }
+
+
+// PAGERANK-CONTRIBUTION
+// ---------------------
+// Copy contributions of vertices in range (to the other buffer).
+
+template <class T, class O>
+void pagerankContributionCopyOmp(vector<T>& cn, const vector<T>& c, const PagerankCsrCopy<O>& xc, int i, int n) {
+  const int *ks = xc.ks;
+  if (!ks) { copyOmp(cn, c, i, n); return; }
+  #pragma omp parallel for schedule(static, 2048)
+  for (int j=i; j<i+n; j++)
+    cn[ks[j]] = c[ks[j]];
+}
+
+template <class T, class V>
+void pagerankContributionCopyOmp(vector<T>& cn, const vector<T>& c, const PagerankCsrView<V>& xc, int i, int n) {
+  const int *ks = xc.ks.data();
+  #pragma omp parallel for schedule(static, 2048)
+  for (int j=i; j<i+n; j++)
+    cn[ks[j]] = c[ks[j]];
+}
+
+template <class T, class O>
+void pagerankContributionCopyOmp(vector<T>& cn, const vector<T>& c, const PagerankCsrPacked<O>& xc, int i, int n) {
+  const int *ks = xc.ks;
+  if (!ks) { copyOmp(cn, c, i, n); return; }
+  #pragma omp parallel for schedule(static, 2048)
+  for (int j=i; j<i+n; j++)
+    cn[ks[j]] = c[ks[j]];
 }
 
 
@@ -65,27 +294,254 @@ T pagerankErrorOmp(const vector<T>& x, const vector<T>& y, int i, int N, int EF)
 // PAGERANK
 // --------
 // For Monolithic / Componentwise PageRank.
+// Loop (fl) is called with in-edges in the chosen format (see EdgeFormat).
+
+// Uses a copy of in-edges in format C, ranks are indexed by position.
+template <class C, class H, class J, class M, class FL, class T=float>
+PagerankResult<T> pagerankCopyOmp(const H& xt, const J& ks, int i, const M& ns, FL fl, const vector<T> *q, const PagerankOptions<T>& o) {
+  int  N  = xt.order();
+  T    p  = o.damping;
+  T    E  = o.tolerance;
+  int  L  = o.maxIterations, l = 0;
+  int  EF = o.toleranceNorm;
+  decltype(vertexData(xt, ks)) vdata;
+  C xc;
+  PagerankPhases tp;
+  vector<T> a(N), r(N), c(N), cn(N), f(N), qc;
+  tp.csr = measureDuration([&] {
+    vdata = vertexData(xt, ks);
+    pagerankCsrFrom(xc, xt, ks);
+    if (q) qc = compressContainer(xt, *q, ks);
+  });
+  float t = 0;
+  measureDurationMarked([&](auto mark) {
+    tp.initialize += measureDuration([&] {
+      if (q) copyOmp(r, qc);  // copy old ranks (qc), if given
+      else fillOmp(r, T(1)/N);
+      copyOmp(a, r);
+      pagerankFactorOmp(f, vdata, 0, N, p); multiplyOmp(c, a, f, 0, N); copyOmp(cn, c);  // calculate factors (f) and contributions (c, cn)
+    });
+    mark([&] { t += fl(a, r, c, cn, f, xc, i, ns, N, p, E, L, EF); });                    // calculate ranks of vertices
+  }, o.repeat);
+  t /= o.repeat;
+  tp.initialize /= o.repeat;
+  tp.iterate = t;
+  vector<T> b;
+  tp.decompress = measureDuration([&] { b = decompressContainer(xt, a, ks); });
+  return {b, l, t, tp};
+}
 
 template <class H, class J, class M, class FL, class T=float>
 PagerankResult<T> pagerankOmp(const H& xt, const J& ks, int i, const M& ns, FL fl, const vector<T> *q, const PagerankOptions<T>& o) {
+  bool wide = o.edgeFormat==EDGES_OFFSET64 || xt.size() > size_t(INT_MAX);
+  if (o.edgeFormat==EDGES_PACKED) return pagerankCopyOmp<PagerankCsrPacked<>>(xt, ks, i, ns, fl, q, o);
+  if (wide) return pagerankCopyOmp<PagerankCsrCopy<int64_t>>(xt, ks, i, ns, fl, q, o);
+  return pagerankCopyOmp<PagerankCsrCopy<>>(xt, ks, i, ns, fl, q, o);
+}
+
+
+// Uses in-edges in format xc (built in tc ms), ranks are indexed by vertex.
+template <class V, class C, class M, class FL, class T=float>
+PagerankResult<T> pagerankInplaceOmp(const CsrDiGraph<V>& xt, const vector<int>& ks, const C& xc, float tc, int i, const M& ns, FL fl, const vector<T> *q, const PagerankOptions<T>& o) {
+  int  S  = xt.span();
   int  N  = xt.order();
+  int  K  = ks.size();
   T    p  = o.damping;
   T    E  = o.tolerance;
   int  L  = o.maxIterations, l = 0;
   int  EF = o.toleranceNorm;
-  auto vfrom = sourceOffsets(xt, ks);
-  auto efrom = destinationIndices(xt, ks);
-  auto vdata = vertexData(xt, ks);
-  vector<T> a(N), r(N), c(N), f(N), qc;
-  if (q) qc = compressContainer(xt, *q, ks);
+  const auto& vdata = xt.vertexValues();
+  PagerankPhases tp;
+  vector<T> a(S), r(S), c(S), cn(S), f(S);
+  tp.csr = tc;
   float t = 0;
   measureDurationMarked([&](auto mark) {
-    if (q) copyOmp(r, qc);    // copy old ranks (qc), if given
-    else fillOmp(r, T(1)/N);
-    copyOmp(a, r);
-    mark([&] { pagerankFactorOmp(f, vdata, 0, N, p); multiplyOmp(c, a, f, 0, N); });  // calculate factors (f) and contributions (c)
-    mark([&] { t += fl(a, r, c, f, vfrom, efrom, i, ns, N, p, E, L, EF); });           // calculate ranks of vertices
+    tp.initialize += measureDuration([&] {
+      if (q) copyOmp(r.data(), q->data(), min(S, int(q->size())));  // copy old ranks, if given
+      else {
+        #pragma omp parallel for schedule(auto)
+        for (int j=0; j<K; j++)
+          r[ks[j]] = T(1)/N;
+      }
+      copyOmp(a, r);
+      pagerankFactorOmp(f, vdata, 0, S, p); multiplyOmp(c, a, f, 0, S); copyOmp(cn, c);  // calculate factors (f) and contributions (c, cn)
+    });
+    mark([&] { t += fl(a, r, c, cn, f, xc, i, ns, N, p, E, L, EF); });                    // calculate ranks of vertices
   }, o.repeat);
   t /= o.repeat;
-  return {decompressContainer(xt, a, ks), l, t};
+  tp.initialize /= o.repeat;
+  tp.iterate = t;
+  return {a, l, t, tp};
+}
+
+// Uses CSR arrays of graph directly, or a copy of in-edges of vertices (with
+// 64-bit offsets, or packed). Ranks are indexed by vertex in all cases, as the
+// compressed loop (pagerankCompressedOmp) expects.
+template <class V, class M, class FL, class T=float>
+PagerankResult<T> pagerankOmp(const CsrDiGraph<V>& xt, const vector<int>& ks, int i, const M& ns, FL fl, const vector<T> *q, const PagerankOptions<T>& o) {
+  if (o.edgeFormat==EDGES_OFFSET64) {
+    PagerankCsrCopy<int64_t> xc;
+    float tc = measureDuration([&] { pagerankCsrCopyOmp(xc, xt, ks); });
+    return pagerankInplaceOmp(xt, ks, xc, tc, i, ns, fl, q, o);
+  }
+  if (o.edgeFormat!=EDGES_PACKED) return pagerankInplaceOmp(xt, ks, PagerankCsrView<V> {xt, ks}, 0, i, ns, fl, q, o);
+  PagerankCsrPacked<> xc;
+  float tc = measureDuration([&] {
+    pagerankCsrPackOmp(xc, xt, ks, [](int v) { return v; });
+    xc.ks = ks.data();
+  });
+  return pagerankInplaceOmp(xt, ks, xc, tc, i, ns, fl, q, o);
+}
+
+
+
+
+// PAGERANK-FRONTIER
+// -----------------
+// For Dynamic Frontier PageRank (ranks are indexed by vertex).
+// Only affected vertices are updated. Affected set starts at endpoints of
+// updated edges (and out-neighbours of their sources), and grows to the
+// out-neighbours of a vertex only if its rank changes by more than the
+// frontier tolerance (relative).
+
+template <class G>
+void pagerankFrontierMarkOmp(vector<uint8_t>& vaff, const G& y, const vector<pair<int, int>>& es) {
+  int S = vaff.size(), E = es.size();
+  auto fa = [&](int u) {
+    #pragma omp atomic write
+    vaff[u] = 1;
+  };
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (int i=0; i<E; i++) {
+    int u = es[i].first, v = es[i].second;
+    if (u>=0 && u<S) fa(u);
+    if (v>=0 && v<S) fa(v);
+    for (int w : y.edges(u))
+      fa(w);
+  }
+}
+
+
+// Only the frontier (affected vertices of group [i, i+n) of ks) is visited.
+// Vertices newly marked by a thread are collected in its own list (gs), and
+// appended to the frontier (if in this group). They are updated in the same
+// iteration (with the same contributions), until no more are marked.
+template <class G, class H, class T>
+int pagerankFrontierOmpLoop(vector<T>& a, vector<T>& r, vector<T>& c, const vector<T>& f, vector<uint8_t>& vaff, const vector<int>& vpos, const G& y, const H& yt, const vector<int>& ks, int i, int n, int N, T p, T E, T Ef, int L, int EF) {
+  T  c0 = (1-p)/N;
+  int l = 0;
+  vector<int> fs;
+  vector2d<int> gs(omp_get_max_threads());
+  for (int j=i; j<i+n; j++)
+    if (vaff[ks[j]]) fs.push_back(ks[j]);
+  while (l<L) {
+    T e1 = T(), e2 = T(), ei = T();
+    int F0 = fs.size();
+    for (int k0=0, F=F0; k0<F; k0=F, F=fs.size()) {
+      #pragma omp parallel reduction(+:e1,e2) reduction(max:ei)
+      {
+        auto& g = gs[omp_get_thread_num()];
+        #pragma omp for schedule(dynamic, 2048) nowait
+        for (int k=k0; k<F; k++) {
+          int v = fs[k];
+          T s = T();
+          for (int u : yt.edges(v))
+            s += c[u];
+          a[v] = c0 + s;
+          T dv = abs(a[v] - r[v]);
+          e1 += dv; e2 += dv*dv; ei = max(ei, dv);
+          if (dv <= Ef * max(a[v], r[v])) continue;
+          for (int w : y.edges(v)) {  // expand frontier
+            uint8_t old;
+            #pragma omp atomic read
+            old = vaff[w];
+            if (old) continue;
+            #pragma omp atomic capture
+            { old = vaff[w]; vaff[w] = 1; }
+            if (!old && vpos[w]>=i && vpos[w]<i+n) g.push_back(w);
+          }
+        }
+      }
+      for (auto& g : gs) {
+        fs.insert(fs.end(), g.begin(), g.end());
+        g.clear();
+      }
+    }
+    if (int(fs.size())>F0) sort(fs.begin(), fs.end(), [&](int u, int v) { return vpos[u] < vpos[v]; });  // keep in order of ks
+    T el = EF==1? e1 : (EF==2? sqrt(e2) : ei);  // one iteration complete
+    ++l;
+    if (el<E || l>=L) break;                      // check tolerance, iteration limit
+    int F = fs.size();
+    #pragma omp parallel for schedule(static, 2048)
+    for (int k=0; k<F; k++) {
+      int v = fs[k];
+      c[v] = a[v] * f[v];                         // update partial contributions (c)
+    }
+    swap(a, r);
+  }
+  // Final ranks, contributions of this group (for next groups).
+  // Vertices outside the frontier are unchanged (a[v] = r[v]).
+  int F = fs.size();
+  #pragma omp parallel for schedule(static, 2048)
+  for (int k=0; k<F; k++) {
+    int v = fs[k];
+    r[v] = a[v];
+    c[v] = a[v] * f[v];
+  }
+  return l;
+}
+
+
+// Find dynamic frontier pagerank, with vertices in groups (ns) of order ks.
+// @param y  updated graph
+// @param yt transpose of updated graph (with vertex-data=out-degree)
+// @param q  ranks of old graph (all vertices affected if not given)
+template <class G, class H, class J, class T=float>
+PagerankResult<T> pagerankFrontierOmp(const G& y, const H& yt, const vector<int>& ks, const J& ns, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const vector<T> *q, const PagerankOptions<T>& o) {
+  int  S  = yt.span();
+  int  N  = yt.order();
+  int  K  = ks.size();
+  T    p  = o.damping;
+  T    E  = o.tolerance;
+  T    Ef = o.frontierTolerance;
+  int  L  = o.maxIterations, l = 0;
+  int  EF = o.toleranceNorm;
+  vector<T> a(S), r(S), c(S), f(S);
+  vector<uint8_t> vaff(S);
+  vector<int>     vpos(S, -1);
+  PagerankPhases  tp;
+  float t = measureDurationMarked([&](auto mark) {
+    tp.initialize += measureDuration([&] {
+      if (q) copyOmp(r.data(), q->data(), min(S, int(q->size())));  // copy old ranks, if given
+      else {
+        #pragma omp parallel for schedule(auto)
+        for (int j=0; j<K; j++)
+          r[ks[j]] = T(1)/N;
+      }
+      fillOmp(vaff, q? 0 : 1);
+      #pragma omp parallel for schedule(auto)
+      for (int j=0; j<K; j++)
+        vpos[ks[j]] = j;
+      copyOmp(a, r);
+      #pragma omp parallel for schedule(auto)
+      for (int u=0; u<S; u++) {
+        int d = yt.vertexData(u);
+        f[u] = d>0? p/d : 0;
+        c[u] = r[u] * f[u];
+      }
+    });
+    mark([&] {
+      pagerankFrontierMarkOmp(vaff, y, deletions);
+      pagerankFrontierMarkOmp(vaff, y, insertions);
+      l = 0;
+      int i = 0;
+      for (int n : ns) {
+        l += pagerankFrontierOmpLoop(a, r, c, f, vaff, vpos, y, yt, ks, i, n, N, p, E, Ef, L, EF);
+        i += n;
+      }
+    });
+  }, o.repeat);
+  tp.initialize /= o.repeat;
+  tp.iterate = t;
+  return {a, l, t, tp};
 }
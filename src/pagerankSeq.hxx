@@ -1,12 +1,15 @@
 #pragma once
 #include <vector>
+#include <cstdint>
 #include <algorithm>
 #include "_main.hxx"
 #include "vertices.hxx"
 #include "edges.hxx"
 #include "csr.hxx"
+#include "order.hxx"
 #include "pagerank.hxx"
 
+using std::pair;
 using std::vector;
 using std::swap;
 
@@ -16,24 +19,103 @@ using std::swap;
 // PAGERANK-VERTICES
 // -----------------
 
+// Reorder vertices in range [i, i+n) of ks, as per options.
+template <class G, class H, class T>
+void pagerankOrderVertices(vector<int>& ks, int i, int n, const G& x, const H& xt, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
+  switch (o.vertexOrder) {
+    case ORDER_DEGREE: degreeOrder(ks, i, n, x); break;
+    case ORDER_RCM:    rcmOrder(ks, i, n, x, xt); break;
+    case ORDER_COMPONENT: {
+      PagerankData<G> Dx;
+      const auto& cs = componentsD(Dx, x, xt, D);
+      const auto& ci = componentIdsD(Dx, x, cs, D);
+      componentOrder(ks, i, n, x, xt, ci);
+      break;
+    }
+    default: break;
+  }
+}
+
+
+// Reorder vertices in range [i, i+n) of ks, with marks (vin, clear) and
+// component ids (cids) given, so that many ranges can share them.
+template <class G, class H, class T>
+void pagerankOrderVerticesMarked(vector<int>& ks, int i, int n, vector<uint8_t>& vin, const G& x, const H& xt, const vector<int>& cids, const PagerankOptions<T>& o) {
+  switch (o.vertexOrder) {
+    case ORDER_DEGREE: degreeOrder(ks, i, n, x); break;
+    case ORDER_RCM:
+      for (int j=i; j<i+n; j++)
+        vin[ks[j]] = 1;
+      rcmOrderMarked(ks, i, n, vin, x, xt);
+      break;
+    case ORDER_COMPONENT: componentOrderMarked(ks, i, n, vin, x, xt, cids); break;
+    default: break;
+  }
+}
+
+
 template <class G, class H, class T>
 auto pagerankVertices(const G& x, const H& xt, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
-  if (!o.splitComponents) return vertices(xt);
-  return join<int>(componentsD(x, xt, D));
+  if (!o.splitComponents) {
+    auto ks = vertices(xt);
+    pagerankOrderVertices(ks, 0, ks.size(), x, xt, o, D);
+    return ks;
+  }
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, x, xt, D);
+  auto ks = join<int>(cs);
+  if (o.vertexOrder==ORDER_NONE) return ks;
+  // Keep components together (in order), finding ids and marks once.
+  const vector<int> ci0;
+  const auto& ci = o.vertexOrder==ORDER_COMPONENT? componentIdsD(Dx, x, cs, D) : ci0;
+  vector<uint8_t> vin(x.span());
+  for (int i=0, j=0; i<int(cs.size()); j+=cs[i++].size())
+    pagerankOrderVerticesMarked(ks, j, cs[i].size(), vin, x, xt, ci, o);
+  return ks;
 }
 
 
 template <class G, class H, class T>
-auto pagerankDynamicVertices(const G& x, const H& xt, const G& y, const H& yt, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
+auto pagerankDynamicVerticesUnordered(const G& x, const H& xt, const G& y, const H& yt, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
   if (!o.splitComponents) return dynamicVertices(x, xt, y, yt);
-  const auto& cs = componentsD(y, yt, D);
-  const auto& b  = blockgraphD(y, cs, D);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, y, yt, D);
+  const auto& b  = blockgraphD(Dx, y, cs, D);
   auto [is, n] = dynamicComponentIndices(x, xt, y, yt, cs, b);
   auto ks = joinAt<int>(cs, sliceIter(is, 0, n)); size_t nv = ks.size();
   joinAt(ks, cs, sliceIter(is, n));
   return make_pair(ks, nv);
 }
 
+template <class G, class H, class T>
+auto pagerankDynamicVerticesUnordered(const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
+  if (!o.splitComponents) return dynamicVerticesFrom(y, deletions, insertions);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, y, yt, D);
+  const auto& ci = componentIdsD(Dx, y, cs, D);
+  const auto& b  = blockgraphD(Dx, y, cs, D);
+  auto [is, n] = dynamicComponentIndicesFrom(cs, ci, b, deletions, insertions);
+  auto ks = joinAt<int>(cs, sliceIter(is, 0, n)); size_t nv = ks.size();
+  joinAt(ks, cs, sliceIter(is, n));
+  return make_pair(ks, nv);
+}
+
+
+// Affected vertices come first, and are reordered as per options.
+template <class G, class H, class T>
+auto pagerankDynamicVertices(const G& x, const H& xt, const G& y, const H& yt, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
+  auto [ks, n] = pagerankDynamicVerticesUnordered(x, xt, y, yt, o, D);
+  pagerankOrderVertices(ks, 0, n, y, yt, o, D);
+  return make_pair(ks, n);
+}
+
+template <class G, class H, class T>
+auto pagerankDynamicVertices(const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
+  auto [ks, n] = pagerankDynamicVerticesUnordered(y, yt, deletions, insertions, o, D);
+  pagerankOrderVertices(ks, 0, n, y, yt, o, D);
+  return make_pair(ks, n);
+}
+
 
 
 
@@ -43,7 +125,8 @@ auto pagerankDynamicVertices(const G& x, const H& xt, const G& y, const H& yt, c
 template <class G, class H, class T>
 auto pagerankComponents(const G& x, const H& xt, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
   if (!o.splitComponents) return vector2d<int> {vertices(xt)};
-  return componentsD(x, xt, D);
+  PagerankData<G> Dx;
+  return componentsD(Dx, x, xt, D);
 }
 
 
@@ -58,8 +141,9 @@ auto pagerankDynamicComponentsDefault(const G& x, const H& xt, const G& y, const
 
 template <class G, class H, class T>
 auto pagerankDynamicComponentsSplit(const G& x, const H& xt, const G& y, const H& yt, const PagerankOptions<T>& o, const PagerankData<G> *D=nullptr) {
-  const auto& cs = componentsD(y, yt, D);
-  const auto& b  = blockgraphD(y, cs, D);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, y, yt, D);
+  const auto& b  = blockgraphD(Dx, y, cs, D);
   auto [is, n] = dynamicComponentIndices(x, xt, y, yt, cs, b);
   vector2d<int> a;
   for (int i : is)
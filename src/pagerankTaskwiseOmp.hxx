@@ -0,0 +1,234 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "_main.hxx"
+#include "vertices.hxx"
+#include "components.hxx"
+#include "dynamic.hxx"
+#include "pagerank.hxx"
+
+using std::pair;
+using std::vector;
+using std::min;
+using std::max;
+using std::abs;
+using std::sqrt;
+
+
+
+
+// PAGERANK-COMPONENT
+// ------------------
+// Find ranks of a component, given final contributions of its predecessors.
+// Ranks are indexed by vertex, and r, c are updated after each iteration.
+// A large component is split across threads (taskloop).
+
+template <class H, class T>
+T pagerankTaskwiseCalculate(vector<T>& a, const vector<T>& r, const vector<T>& c, const H& xt, const vector<int>& ks, int i, int I, T c0, int EF) {
+  T e = T();
+  for (int j=i; j<I; j++) {
+    int v = ks[j]; T s = T();
+    for (int u : xt.edges(v))
+      s += c[u];
+    a[v] = c0 + s;
+    T d = abs(a[v] - r[v]);
+    e = EF==1? e+d : (EF==2? e+d*d : max(e, d));
+  }
+  return e;
+}
+
+template <class T>
+void pagerankTaskwiseUpdate(const vector<T>& a, vector<T>& r, vector<T>& c, const vector<T>& f, const vector<int>& ks, int i, int I) {
+  for (int j=i; j<I; j++) {
+    int v = ks[j];
+    r[v] = a[v];
+    c[v] = a[v] * f[v];
+  }
+}
+
+
+template <class H, class T>
+int pagerankTaskwiseOmpComponent(vector<T>& a, vector<T>& r, vector<T>& c, const vector<T>& f, const H& xt, const vector<int>& ks, int N, T p, T E, int L, int EF, bool split) {
+  const int B = 2048;
+  int n  = ks.size(), K = ceilDiv(n, B);
+  T   c0 = (1-p)/N, En = EF<=2? E*n/N : E;
+  vector<T> es(split? K : 0);
+  int l = 0;
+  while (l<L) {
+    T el = T();
+    if (!split) {
+      el = pagerankTaskwiseCalculate(a, r, c, xt, ks, 0, n, c0, EF);
+      pagerankTaskwiseUpdate(a, r, c, f, ks, 0, n);
+    }
+    else {
+      #pragma omp taskloop grainsize(1) default(shared)
+      for (int h=0; h<K; h++)
+        es[h] = pagerankTaskwiseCalculate(a, r, c, xt, ks, h*B, min(n, (h+1)*B), c0, EF);
+      #pragma omp taskloop grainsize(1) default(shared)
+      for (int h=0; h<K; h++)
+        pagerankTaskwiseUpdate(a, r, c, f, ks, h*B, min(n, (h+1)*B));
+      for (T e : es)
+        el = EF<=2? el+e : max(el, e);
+    }
+    if (EF==2) el = sqrt(el);
+    ++l;                            // one iteration complete
+    if (el<En || l>=L) break;       // check tolerance, iteration limit
+  }
+  return l;
+}
+
+
+
+
+// PAGERANK-LOOP
+// -------------
+// Run each component as a task, as soon as its predecessors have converged.
+// Small components run on a single thread, and a small successor that
+// becomes ready is run by the same task (instead of spawning a new one).
+
+template <class G, class H, class T>
+struct PagerankTaskwiseOmpState {
+  vector<T>& a;
+  vector<T>& r;
+  vector<T>& c;
+  const vector<T>& f;
+  const H& xt;
+  const G& b;
+  const vector2d<int>& cs;
+  vector<int> deps;     // no. of unfinished predecessors
+  vector<int> work;     // vertices + in-edges
+  vector<uint8_t> run;  // component to be run?
+  int N; T p, E; int L, EF;
+  int l = 0;
+};
+
+
+template <class S>
+void pagerankTaskwiseOmpTask(S *s, int c) {
+  const int W = MIN_SPLIT_PR();
+  while (c>=0) {
+    int l = pagerankTaskwiseOmpComponent(s->a, s->r, s->c, s->f, s->xt, s->cs[c], s->N, s->p, s->E, s->L, s->EF, s->work[c]>=W);
+    #pragma omp critical
+    s->l = max(s->l, l);
+    int next = -1;
+    for (int d : s->b.edges(c)) {
+      if (!s->run[d]) continue;
+      int k;
+      #pragma omp atomic capture
+      k = --s->deps[d];
+      if (k>0) continue;
+      if (next<0 && s->work[d]<W) { next = d; continue; }
+      #pragma omp task firstprivate(s, d)
+      pagerankTaskwiseOmpTask(s, d);
+    }
+    c = next;
+  }
+}
+
+
+template <class G, class H, class T>
+int pagerankTaskwiseOmpLoop(vector<T>& a, vector<T>& r, vector<T>& c, const vector<T>& f, const H& xt, const G& b, const G& bt, const vector2d<int>& cs, const vector<int>& is, int N, T p, T E, int L, int EF) {
+  int C = cs.size();
+  PagerankTaskwiseOmpState<G, H, T> s {a, r, c, f, xt, b, cs, vector<int>(C), vector<int>(C), vector<uint8_t>(C), N, p, E, L, EF};
+  for (int i : is)
+    s.run[i] = 1;
+  for (int i : is) {
+    for (int d : bt.edges(i))
+      if (s.run[d]) s.deps[i]++;
+    s.work[i] = cs[i].size();
+    for (int v : cs[i])
+      s.work[i] += xt.degree(v);
+  }
+  // Find roots first (tasks may update deps, once spawned).
+  vector<int> rs;
+  for (int i : is)
+    if (s.deps[i]==0) rs.push_back(i);
+  auto *ps = &s;
+  #pragma omp parallel
+  #pragma omp single
+  for (int i : rs) {
+    #pragma omp task firstprivate(ps, i)
+    pagerankTaskwiseOmpTask(ps, i);
+  }
+  return s.l;
+}
+
+
+template <class G, class H, class T>
+PagerankResult<T> pagerankTaskwiseOmpRun(const H& xt, const G& b, const G& bt, const vector2d<int>& cs, const vector<int>& is, const vector<T> *q, const PagerankOptions<T>& o) {
+  int  S  = xt.span();
+  int  N  = xt.order();
+  T    p  = o.damping;
+  T    E  = o.tolerance;
+  int  L  = o.maxIterations, l = 0;
+  int  EF = o.toleranceNorm;
+  vector<T> a(S), r(S), c(S), f(S);
+  PagerankPhases tp;
+  float t = measureDurationMarked([&](auto mark) {
+    tp.initialize += measureDuration([&] {
+      if (q) copyOmp(r.data(), q->data(), min(S, int(q->size())));  // copy old ranks, if given
+      #pragma omp parallel for schedule(auto)
+      for (int u=0; u<S; u++) {
+        int d = xt.vertexData(u);
+        if (!q) r[u] = xt.hasVertex(u)? T(1)/N : T();
+        f[u] = d>0? p/d : 0;
+        c[u] = r[u] * f[u];
+      }
+      copyOmp(a, r);
+    });
+    mark([&] { l = pagerankTaskwiseOmpLoop(a, r, c, f, xt, b, bt, cs, is, N, p, E, L, EF); });
+  }, o.repeat);
+  tp.initialize /= o.repeat;
+  tp.iterate = t;
+  return {a, l, t, tp};
+}
+
+
+
+
+// PAGERANK (STATIC / INCREMENTAL)
+// -------------------------------
+
+// Find pagerank with components scheduled as tasks over the blockgraph.
+// @param x  original graph
+// @param xt transpose graph (with vertex-data=out-degree)
+// @param q  initial ranks (optional)
+// @param o  options {damping=0.85, tolerance=1e-6, maxIterations=500}
+// @returns {ranks, iterations (of slowest component), time}
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankTaskwiseOmp(const G& x, const H& xt, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  int  N  = xt.order();  if (N==0) return PagerankResult<T>::initial(xt, q);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, x, xt, D);
+  const auto& b  = blockgraphD(Dx, x, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
+  auto is = vertices(bt);
+  return pagerankTaskwiseOmpRun(xt, b, bt, cs, is, q, o);
+}
+
+
+
+
+// PAGERANK (DYNAMIC)
+// ------------------
+
+// Find pagerank with only affected components scheduled, from a batch of edge updates.
+// @param y  updated graph
+// @param yt transpose of updated graph (with vertex-data=out-degree)
+// @param deletions edges removed from old graph
+// @param insertions edges added to old graph
+template <class G, class H, class T=float>
+PagerankResult<T> pagerankTaskwiseOmpDynamic(const G& y, const H& yt, const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const vector<T> *q=nullptr, const PagerankOptions<T>& o={}, const PagerankData<G> *D=nullptr) {
+  int  N  = yt.order();  if (N==0) return PagerankResult<T>::initial(yt, q);
+  PagerankData<G> Dx;
+  const auto& cs = componentsD(Dx, y, yt, D);
+  const auto& ci = componentIdsD(Dx, y, cs, D);
+  const auto& b  = blockgraphD(Dx, y, cs, D);
+  const auto& bt = blockgraphTransposeD(Dx, b, D);
+  auto [is, n] = dynamicComponentIndicesFrom(cs, ci, b, deletions, insertions);  if (n==0) return PagerankResult<T>::initial(yt, q);
+  is.resize(n);
+  return pagerankTaskwiseOmpRun(yt, b, bt, cs, is, q, o);
+}
@@ -1,5 +1,14 @@
 #pragma once
+#include <utility>
+#include <vector>
+#include <algorithm>
 #include "copy.hxx"
+#include "deadEnds.hxx"
+
+using std::pair;
+using std::vector;
+using std::sort;
+using std::unique;
 
 
 
@@ -55,3 +64,47 @@ auto selfLoop(const G& x, F fn) {
   auto a = copy(x); selfLoopTo(a, fn);
   return a;
 }
+
+
+
+
+// SELF-LOOP DEAD-ENDS (DYNAMIC)
+// -----------------------------
+// Extend a batch of updates of a graph (xo -> yo), so that it also updates
+// the graph with self-loops on dead ends (x -> y). Batch is kept sorted.
+// To update xo in-place, mark dead ends (before) and then extend the batch.
+
+template <class G>
+auto selfLoopDeadEndsMark(const vector<pair<int, int>>& deletions, const vector<pair<int, int>>& insertions, const G& xo) {
+  vector<pair<int, bool>> a; vector<int> ws;
+  for (const auto& [u, v] : deletions)
+    ws.push_back(u);
+  for (const auto& [u, v] : insertions) {
+    ws.push_back(u);
+    ws.push_back(v);
+  }
+  sort(ws.begin(), ws.end());
+  ws.erase(unique(ws.begin(), ws.end()), ws.end());
+  for (int w : ws)
+    a.push_back({w, xo.hasVertex(w) && isDeadEnd(xo, w)});
+  return a;
+}
+
+
+template <class G>
+void selfLoopDeadEndsExtend(vector<pair<int, int>>& deletions, vector<pair<int, int>>& insertions, const vector<pair<int, bool>>& ws, const G& yo) {
+  for (const auto& [w, x0] : ws) {
+    bool y0 = yo.hasVertex(w) && isDeadEnd(yo, w);
+    if (y0 && !x0) insertions.push_back({w, w});
+    if (x0 && !y0 && !yo.hasEdge(w, w)) deletions.push_back({w, w});
+  }
+  sort(deletions.begin(), deletions.end());
+  sort(insertions.begin(), insertions.end());
+}
+
+
+template <class G>
+void selfLoopDeadEndsBatch(vector<pair<int, int>>& deletions, vector<pair<int, int>>& insertions, const G& xo, const G& yo) {
+  auto ws = selfLoopDeadEndsMark(deletions, insertions, xo);
+  selfLoopDeadEndsExtend(deletions, insertions, ws, yo);
+}
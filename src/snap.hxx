@@ -3,6 +3,8 @@
 #include <vector>
 #include <istream>
 #include <sstream>
+#include <cstdint>
+#include <cstdlib>
 
 using std::string;
 using std::vector;
@@ -37,3 +39,28 @@ bool readSnapTemporal(G& a, istream& s, int N, bool sym=false) {
   a.correct();
   return i>0;
 }
+
+
+
+
+// READ-SNAP-TEMPORAL-EDGE
+// -----------------------
+// Read next edge "u v t" of a stream, skipping comments / blank lines.
+
+struct TemporalEdge {
+  int u, v;
+  int64_t t;  // timestamp (seconds)
+};
+
+
+bool readSnapTemporalEdge(istream& s, TemporalEdge& a) {
+  string ln;
+  while (getline(s, ln)) {
+    const char *p = ln.c_str(); char *q;
+    a.u = strtol(p, &q, 10); if (q==p) continue; p = q;
+    a.v = strtol(p, &q, 10); if (q==p) continue; p = q;
+    a.t = strtoll(p, &q, 10);
+    return true;
+  }
+  return false;
+}
@@ -84,11 +84,11 @@ auto levelwiseGroups(const H& xt) {
 
 template <class H>
 auto levelwiseGroupIndices(const H& xt) {
-  unordered_map<int, int> a; int i = 0;
-  auto fn   = [&](int u) { a[u] = i; };
+  auto a = createContainer(xt, int()); int i = 0, N = 0;
+  auto fn   = [&](int u) { a[u] = i; ++N; };
   auto vis  = createContainer(xt, bool());
   auto visx = createContainer(xt, bool());
-  for (; a.size() < xt.order(); i++)
+  for (; N < xt.order(); i++)
     levelwiseSortDo(visx, vis, xt, fn);
   return a;
 }
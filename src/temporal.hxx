@@ -0,0 +1,113 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include <deque>
+#include <istream>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include "snap.hxx"
+
+using std::pair;
+using std::vector;
+using std::deque;
+using std::istream;
+using std::sort;
+using std::unordered_map;
+
+
+
+
+// TEMPORAL-READER
+// ---------------
+// Reads a temporal edge stream in batches of N edges, or T seconds
+// (or both, whichever comes first). Edges must be in timestamp order.
+
+class TemporalReader {
+  istream& s;
+  TemporalEdge e;        // next edge (read ahead)
+  bool pending = false;
+  bool done    = false;
+
+  public:
+  TemporalReader(istream& s) : s(s) {}
+
+  bool eof() const { return done && !pending; }
+
+  bool peek(TemporalEdge& a) {
+    if (!pending && !done) {
+      pending = readSnapTemporalEdge(s, e);
+      done    = !pending;
+    }
+    a = e;
+    return pending;
+  }
+
+  // Read next batch (0 for no limit on edges N, or duration T).
+  bool readBatch(vector<TemporalEdge>& a, size_t N, int64_t T) {
+    TemporalEdge f;
+    a.clear();
+    while ((N==0 || a.size()<N) && peek(f)) {
+      if (T>0 && !a.empty() && f.t >= a[0].t + T) break;
+      a.push_back(f);
+      pending = false;
+    }
+    return !a.empty();
+  }
+};
+
+
+
+
+// SLIDING-WINDOW
+// --------------
+// Edges seen within the last W seconds (and / or last WE edges) of a stream.
+// Duplicate edges are counted, and an edge is deleted from the graph only
+// when its last copy expires.
+
+class SlidingWindow {
+  deque<TemporalEdge> es;
+  unordered_map<uint64_t, int> counts;  // copies of each edge in window
+  int64_t W;
+  size_t  WE;
+
+  static uint64_t key(int u, int v) { return (uint64_t(uint32_t(u)) << 32) | uint32_t(v); }
+
+  public:
+  size_t size()  const { return es.size(); }   // edges in window (with duplicates)
+  size_t edges() const { return counts.size(); }
+
+  SlidingWindow(int64_t W=0, size_t WE=0) : W(W), WE(WE) {}
+
+  // Add a batch of edges, and expire old ones.
+  // Net change to the graph is returned as sorted deletions, insertions.
+  void update(vector<pair<int, int>>& deletions, vector<pair<int, int>>& insertions, const vector<TemporalEdge>& batch) {
+    unordered_map<uint64_t, int> before;  // copies before batch (of touched edges)
+    auto touch = [&](uint64_t k, int d) {
+      auto it = counts.find(k);
+      int  c  = it==counts.end()? 0 : it->second;
+      before.insert({k, c});
+      if (c+d==0) counts.erase(k);
+      else counts[k] = c+d;
+    };
+    deletions.clear();
+    insertions.clear();
+    for (const auto& e : batch) {
+      es.push_back(e);
+      touch(key(e.u, e.v), 1);
+    }
+    int64_t t = es.empty()? 0 : es.back().t;
+    while (!es.empty() && ((W>0 && es.front().t <= t-W) || (WE>0 && es.size()>WE))) {
+      touch(key(es.front().u, es.front().v), -1);
+      es.pop_front();
+    }
+    for (const auto& [k, c0] : before) {
+      int u = int(k >> 32), v = int(k & 0xFFFFFFFF);
+      bool c1 = counts.count(k) > 0;
+      if (c0==0 &&  c1) insertions.push_back({u, v});
+      if (c0>0  && !c1) deletions.push_back({u, v});
+    }
+    sort(deletions.begin(), deletions.end());
+    sort(insertions.begin(), insertions.end());
+  }
+};
@@ -1,5 +1,13 @@
 #pragma once
+#include <vector>
+#include "_main.hxx"
 #include "DiGraph.hxx"
+#include "CsrGraph.hxx"
+#include "CsrDiGraph.hxx"
+#include "csr.hxx"
+
+using std::vector;
+using std::move;
 
 
 
@@ -47,3 +55,39 @@ auto transposeWithDegree(const G& x) {
   DiGraph<int, E> a; transposeWithDegree(a, x);
   return a;
 }
+
+
+// Build transpose CSR directly, in parallel.
+template <class V>
+auto transposeWithDegree(const CsrGraph<V>& x) {
+  int S = x.span(), P = omp_get_max_threads();
+  const size_t *eoff = x.offsets();
+  const int    *ekey = x.edgeKeys();
+  auto [offs, keys] = csrFromEdgesOmp(S, P, [&](int t, auto fn) {
+    for (int u=int(int64_t(S)*t/P), U=int(int64_t(S)*(t+1)/P); u<U; u++) {
+      for (size_t i=eoff[u]; i<eoff[u+1]; i++)
+        fn(ekey[i], u);
+    }
+  });
+  vector<uint8_t> vex(x.vertexFlags(), x.vertexFlags()+S);
+  vector<int> degs(S);
+  #pragma omp parallel for schedule(static, 2048)
+  for (int u=0; u<S; u++)
+    degs[u] = int(eoff[u+1] - eoff[u]);
+  return CsrGraph<int>(move(vex), move(offs), move(keys), move(degs));
+}
+
+template <class V>
+auto transposeWithDegree(const CsrDiGraph<V>& x) {
+  int S = x.span(), P = omp_get_max_threads();
+  const auto& eoff = x.offsets();
+  const auto& edeg = x.degrees();
+  const auto& ekey = x.edgeKeys();
+  auto [offs, keys] = csrFromEdgesOmp(S, P, [&](int t, auto fn) {
+    for (int u=int(int64_t(S)*t/P), U=int(int64_t(S)*(t+1)/P); u<U; u++) {
+      for (size_t i=eoff[u]; i<eoff[u]+edeg[u]; i++)
+        fn(ekey[i], u);
+    }
+  });
+  return CsrDiGraph<int>(S, x.vertexFlags().data(), edeg.data(), offs.data(), keys.data());
+}
@@ -0,0 +1,251 @@
+#include <cmath>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <utility>
+#include <fstream>
+#include <iostream>
+#include <future>
+#include <chrono>
+#include <algorithm>
+#include <omp.h>
+#include "src/main.hxx"
+
+using namespace std;
+
+
+
+
+// OPTIONS
+// -------
+// Dynamic pagerank on a temporal edge stream (g++ -std=c++17 -fopenmp -O3 stream.cxx).
+
+struct StreamOptions {
+  string  file;              // SNAP temporal edges ("-" for stdin)
+  size_t  batchEdges  = 0;   // edges per batch (0 for no limit)
+  int64_t batchTime   = 0;   // seconds per batch (0 for no limit)
+  int64_t window      = 0;   // expire edges older than this (seconds, 0 to keep)
+  size_t  windowEdges = 0;   // keep only the latest edges (0 to keep)
+  int     maxBatches  = 0;   // stop after this many batches (0 for all)
+  int     applyThreads = 1;  // threads for applying next batch (pipelined)
+  bool    pipeline = true;
+  bool    check    = false;  // find error against static pagerank
+  bool    verbose  = false;
+};
+
+
+void printUsage(const char *cmd) {
+  fprintf(stderr,
+    "Usage: %s [options] <temporal-edges.txt | ->\n"
+    "  -e, --batch-edges  <n>  edges per batch\n"
+    "  -T, --batch-time   <s>  seconds (of timestamps) per batch\n"
+    "  -w, --window       <s>  sliding window, expire older edges as deletions\n"
+    "  -W, --window-edges <n>  sliding window of latest edges\n"
+    "  -n, --batches      <n>  stop after n batches\n"
+    "  -a, --apply-threads <n> threads applying the next batch (default: 1)\n"
+    "  -s, --sequential        do not overlap next batch with pagerank\n"
+    "  -c, --check             report error against static pagerank\n"
+    "  -v, --verbose           print every batch\n", cmd);
+}
+
+
+bool readOptions(StreamOptions& o, int argc, char **argv) {
+  for (int i=1; i<argc; i++) {
+    string k = argv[i];
+    bool   v = i+1<argc;
+    if (k=="-h" || k=="--help") return false;
+    else if (k=="-s" || k=="--sequential") o.pipeline = false;
+    else if (k=="-c" || k=="--check")   o.check   = true;
+    else if (k=="-v" || k=="--verbose") o.verbose = true;
+    else if ((k=="-e" || k=="--batch-edges")   && v) o.batchEdges  = stoull(argv[++i]);
+    else if ((k=="-T" || k=="--batch-time")    && v) o.batchTime   = stoll(argv[++i]);
+    else if ((k=="-w" || k=="--window")        && v) o.window      = stoll(argv[++i]);
+    else if ((k=="-W" || k=="--window-edges")  && v) o.windowEdges = stoull(argv[++i]);
+    else if ((k=="-n" || k=="--batches")       && v) o.maxBatches  = stoi(argv[++i]);
+    else if ((k=="-a" || k=="--apply-threads") && v) o.applyThreads = stoi(argv[++i]);
+    else if (k.size()>1 && k[0]=='-') { fprintf(stderr, "Unknown option %s\n", k.c_str()); return false; }
+    else o.file = k;
+  }
+  if (o.batchEdges==0 && o.batchTime==0) o.batchEdges = 1000;
+  return !o.file.empty();
+}
+
+
+
+
+// STREAM-GRAPH
+// ------------
+// Graph (xo), with self-loops on dead ends (x), its transpose, and pagerank data.
+// Two copies are kept when pipelined: one is used by pagerank (batch k), while
+// the other catches up (batch k), and then applies the next batch (k+1).
+
+struct StreamBatch {
+  vector<pair<int, int>> deletions, insertions;  // to xo (from window)
+  vector<pair<int, int>> yd, yi;                 // to x (with self-loops)
+  size_t edges = 0;                              // edges read from stream
+  size_t window = 0;                             // edges in window (after batch)
+  float  parseTime = 0, applyTime = 0;
+  chrono::high_resolution_clock::time_point ready;
+};
+
+
+struct StreamGraph {
+  using G = CsrDiGraph<>;
+  using H = CsrDiGraph<int>;
+  G xo, x;
+  H xt;
+  PagerankData<G> D {G(), G(), {}, {}, {}};
+
+  // Apply a batch, whose self-loop updates are already known.
+  void apply(const StreamBatch& b) {
+    xo.updateEdgesOmp(b.deletions, b.insertions);
+    updateGraphOmp(x, xt, b.yd, b.yi);
+    updatePagerankData(D, x, xt, b.yd, b.yi);
+  }
+
+  // Apply a new batch, finding its self-loop updates.
+  void applyNew(StreamBatch& b) {
+    b.yd = b.deletions;
+    b.yi = b.insertions;
+    auto ws = selfLoopDeadEndsMark(b.deletions, b.insertions, xo);
+    xo.updateEdgesOmp(b.deletions, b.insertions);
+    selfLoopDeadEndsExtend(b.yd, b.yi, ws, xo);
+    updateGraphOmp(x, xt, b.yd, b.yi);
+    updatePagerankData(D, x, xt, b.yd, b.yi);
+  }
+};
+
+
+// Read, window, and apply the next batch to a graph.
+bool streamNext(StreamBatch& b, StreamGraph& g, TemporalReader& rd, SlidingWindow& win, const StreamOptions& o) {
+  vector<TemporalEdge> es;
+  bool ok = true;
+  b.parseTime = measureDuration([&]() {
+    ok = rd.readBatch(es, o.batchEdges, o.batchTime);
+    if (ok) win.update(b.deletions, b.insertions, es);
+  });
+  if (!ok) return false;
+  b.edges  = es.size();
+  b.window = win.size();
+  b.ready = chrono::high_resolution_clock::now();
+  b.applyTime = measureDuration([&]() { g.applyNew(b); });
+  return true;
+}
+
+
+
+
+// STREAM
+// ------
+
+template <class T>
+void adjustStreamRanks(vector<T>& a, const vector<T>& r, const CsrDiGraph<>& y) {
+  int S = y.span(), X = 0, Y = y.order();
+  a.assign(S, T());
+  for (int u=0; u<int(r.size()); u++)
+    if (r[u]>0) X++;
+  // Old ranks are scaled by X/Y (exact for unaffected components), new vertices get 1/Y.
+  for (int u : y.vertices())
+    a[u] = u<int(r.size()) && r[u]>0? r[u]*float(X)/Y : T(1)/Y;
+}
+
+
+float percentile(vector<float> xs, float p) {
+  if (xs.empty()) return 0;
+  sort(xs.begin(), xs.end());
+  size_t i = size_t(ceil(p * xs.size())); i = i>0? i-1 : 0;
+  return xs[min(i, xs.size()-1)];
+}
+
+
+void runStream(istream& s, const StreamOptions& o) {
+  using T = float;
+  using clock = chrono::high_resolution_clock;
+  enum NormFunction { L0=0, L1=1, L2=2, Li=3 };
+  TemporalReader rd(s);
+  SlidingWindow  win(o.window, o.windowEdges);
+  StreamGraph    gs[2];
+  StreamGraph   *ga = &gs[0], *gb = &gs[1];
+  StreamBatch    ba, bb;
+  vector<T> r, s0;
+  vector<float> latencies, computes;
+  size_t edges = 0, updates = 0;
+  float  tcheck = 0;
+  int k = 0;
+  auto start = clock::now();
+  if (!streamNext(ba, *ga, rd, win, o)) return;
+  while (true) {
+    // Start on the next batch with the other graph (catches up first).
+    future<bool> next;
+    auto prepare = [&]() {
+      omp_set_num_threads(o.applyThreads);
+      gb->apply(ba);
+      return (o.maxBatches==0 || k+1<o.maxBatches) && streamNext(bb, *gb, rd, win, o);
+    };
+    if (o.pipeline) next = async(launch::async, prepare);
+    // Find ranks of this batch (seeded with previous ranks).
+    const auto& y = ga->x; const auto& yt = ga->xt;
+    PagerankResult<T> a {vector<T>()};
+    float tc = measureDuration([&]() {
+      if (k==0) a = pagerankLevelwiseOmp(y, yt, (vector<T>*) nullptr, {1, Li}, &ga->D);
+      else {
+        adjustStreamRanks(s0, r, ga->xo);
+        a = pagerankLevelwiseOmpDynamic(y, yt, ba.yd, ba.yi, &s0, {1, Li}, &ga->D);
+      }
+    });
+    auto done = clock::now();
+    r = move(a.ranks);
+    float tl = durationMilliseconds(ba.ready, done);  // apply, wait, pagerank
+    latencies.push_back(tl);
+    computes.push_back(tc);
+    edges   += ba.edges;
+    updates += ba.deletions.size() + ba.insertions.size();
+    if (o.verbose || o.check) {
+      float e = 0;
+      tcheck += measureDuration([&]() {
+        if (!o.check) return;
+        auto b = pagerankMonolithicOmp(y, yt, (vector<T>*) nullptr, {1, Li});
+        e = l1Norm(r, b.ranks);
+      });
+      printf("[%09.3f ms latency] [%09.3f ms parse] [%09.3f ms apply] [%09.3f ms pagerank; %03d iters.] [%.4e err.] batch %d: %zu edges, %zu del, %zu ins, %zu window, %d order, %zu size\n",
+        tl, ba.parseTime, ba.applyTime, tc, a.iterations, e, k, ba.edges, ba.deletions.size(), ba.insertions.size(), ba.window, y.order(), y.size());
+    }
+    bool more;
+    if (o.pipeline) {
+      more = next.get();
+      swap(ga, gb);
+    }
+    else more = (o.maxBatches==0 || k+1<o.maxBatches) && streamNext(bb, *ga, rd, win, o);
+    swap(ba, bb);
+    ++k;
+    if (!more) break;
+  }
+  float t = durationMilliseconds(start, clock::now()) - tcheck;
+  printf("- batches: %d\n", k);
+  printf("- stream-edges: %zu\n", edges);
+  printf("- graph-updates: %zu\n", updates);
+  printf("- total-time: %.3f\n", t);
+  printf("- edges-per-second: %.1f\n", edges / (t/1000));
+  printf("- updates-per-second: %.1f\n", updates / (t/1000));
+  printf("- pagerank-time-avg: %.3f\n", sum(computes) / max(k, 1));
+  printf("- latency-p50: %.3f\n", percentile(latencies, 0.50));
+  printf("- latency-p90: %.3f\n", percentile(latencies, 0.90));
+  printf("- latency-p99: %.3f\n", percentile(latencies, 0.99));
+  printf("- latency-max: %.3f\n", percentile(latencies, 1.00));
+}
+
+
+int main(int argc, char **argv) {
+  StreamOptions o;
+  if (!readOptions(o, argc, argv)) { printUsage(argv[0]); return 1; }
+  printf("Streaming temporal edges %s ...\n", o.file.c_str());
+  if (o.file=="-") runStream(cin, o);
+  else {
+    ifstream f(o.file);
+    if (!f) { fprintf(stderr, "Cannot open %s\n", o.file.c_str()); return 1; }
+    runStream(f, o);
+  }
+  printf("\n");
+  return 0;
+}